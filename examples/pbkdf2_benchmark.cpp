@@ -0,0 +1,46 @@
+#include "PBKDF2.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+// time a derivation in milliseconds
+template <typename Fn>
+static double measure(Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    const uint8_t password[] = "password";
+    const uint8_t salt[] = "salt";
+    const uint32_t iterations = 100000;
+    std::vector<uint8_t> key(256); // eight SHA-256 output blocks
+
+    // one long key, blocks one after another vs blocks in parallel
+    double serial = measure([&] {
+        PBKDF2::deriveSerial(HashAlgorithm::SHA256, password, 8, salt, 4, iterations, key.data(), key.size());
+    });
+    double parallel = measure([&] {
+        PBKDF2::derive(HashAlgorithm::SHA256, password, 8, salt, 4, iterations, key.data(), key.size());
+    });
+    std::cout << "256 byte key:  serial " << serial << " ms, parallel " << parallel << " ms" << std::endl;
+
+    // many passwords, one at a time vs batched
+    std::vector<HashInput> passwords(ThreadPool::shared().size() * 2, HashInput{password, 8});
+    std::vector<uint8_t> keys(passwords.size() * 32);
+    serial = measure([&] {
+        for (size_t i = 0; i < passwords.size(); ++i) {
+            PBKDF2::deriveSerial(HashAlgorithm::SHA256, passwords[i].data, passwords[i].length, salt, 4,
+                                 iterations, keys.data() + i * 32, 32);
+        }
+    });
+    parallel = measure([&] {
+        PBKDF2::deriveBatch(HashAlgorithm::SHA256, passwords.data(), passwords.size(), salt, 4, iterations,
+                            keys.data(), 32);
+    });
+    std::cout << passwords.size() << " passwords: serial " << serial << " ms, batch " << parallel << " ms" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+#ifndef BLAKE3_H
+#define BLAKE3_H
+
+#include <string>
+#include <cstdint>
+
+class HashStateWriter;
+class HashStateReader;
+
+// define class
+class BLAKE3 {
+public:
+    // digest size in bytes
+    static constexpr size_t OutputSize = 32;
+
+    // key size in bytes for keyed hashing
+    static constexpr size_t KeySize = 32;
+
+    // initialize object in hash mode
+    BLAKE3();
+
+    // initialize object in keyed hash mode
+    explicit BLAKE3(const uint8_t key[KeySize]);
+
+    // create object in derive key mode, context should be a hardcoded application specific string
+    static BLAKE3 deriveKey(const std::string& context);
+
+    // update hash
+    void update(const std::string& data);
+
+    // update hash with raw bytes, large inputs are split into subtrees hashed on the shared thread pool
+    void update(const uint8_t* data, size_t length);
+
+    // finalize and return hash
+    std::string final();
+
+    // finalize and write binary hash into digest
+    void final(uint8_t digest[OutputSize]);
+
+    // finalize and write length bytes of extendable output, starting seek bytes into the output stream
+    void finalXof(uint8_t* output, size_t length, uint64_t seek = 0);
+
+    // reset state and buffer, the mode and key are kept
+    void reset();
+
+    // compute hash
+    static std::string hash(const std::string& data);
+
+    // compute binary hash into digest
+    static void hash(const uint8_t* data, size_t length, uint8_t digest[OutputSize]);
+
+    // write streaming state for HashContext::serialize
+    void saveState(HashStateWriter& writer) const;
+
+    // restore streaming state written by saveState
+    void loadState(HashStateReader& reader);
+
+private:
+    // define block and chunk size
+    static constexpr size_t BlockSize = 64;
+    static constexpr size_t ChunkSize = 1024;
+
+    // deepest tree, 2^54 chunks
+    static constexpr size_t MaxDepth = 54;
+
+    // node ready for compression, kept until the root is known
+    struct Node {
+        uint32_t cv[8];
+        uint32_t block[16];
+        uint64_t counter;
+        uint32_t blockLength;
+        uint32_t flags;
+    };
+
+    // key words and mode flags
+    uint32_t key[8];
+    uint32_t mode;
+
+    // chaining value of the current chunk
+    uint32_t chunkState[8];
+
+    // index of the current chunk
+    uint64_t chunkCounter;
+
+    // blocks of the current chunk already compressed
+    size_t blocksCompressed;
+
+    // buffer data before processing, the last block of a chunk stays here until more input arrives
+    uint8_t buffer[BlockSize];
+
+    // current position in the buffer
+    size_t bufferIndex;
+
+    // chaining values of completed subtrees, largest first
+    uint32_t cvStack[MaxDepth][8];
+    size_t cvStackLength;
+
+    // initialize object with key words and mode
+    BLAKE3(const uint32_t keyWords[8], uint32_t mode);
+
+    // feed bytes of the current chunk
+    void chunkUpdate(const uint8_t* data, size_t length);
+
+    // bytes in the current chunk
+    size_t chunkLength() const;
+
+    // start an empty chunk
+    void startChunk(uint64_t counter);
+
+    // last block of the current chunk
+    Node chunkNode() const;
+
+    // parent of two chaining values
+    Node parentNode(const uint32_t left[8], const uint32_t right[8]) const;
+
+    // node at the top of the tree
+    Node rootNode() const;
+
+    // merge completed subtrees until one remains per set bit of totalChunks
+    void mergeStack(uint64_t totalChunks);
+
+    // push chaining value of the subtree starting at chunk counter
+    void pushStack(const uint32_t cv[8], uint64_t counter);
+
+    // chaining values of the two halves of a subtree of whole chunks
+    void subtreeValues(const uint8_t* data, size_t chunks, uint64_t counter, uint32_t left[8], uint32_t right[8]) const;
+
+    // chaining value of a node that is not the root
+    static void nodeValue(const Node& node, uint32_t cv[8]);
+
+    // write output blocks of the root node
+    static void rootOutput(const Node& node, uint8_t* output, size_t length, uint64_t seek);
+};
+
+#endif // BLAKE3_H
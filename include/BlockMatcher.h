@@ -0,0 +1,77 @@
+#ifndef BLOCKMATCHER_H
+#define BLOCKMATCHER_H
+
+#include "HashLite.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// define one known block found in scanned data
+struct BlockMatch {
+    uint64_t offset = 0; // position of the block in the scanned data
+    size_t block = 0;    // index of the known block, in the order blocks were added
+};
+
+// define search for known blocks of one size inside larger data, as in rsync delta transfer or signature scanning
+// a Buzhash rolling hash over every window finds candidates and a strong digest confirms them
+class BlockMatcher {
+public:
+    // initialize for blocks of blockSize bytes confirmed with a strong algorithm, throws runtime_error for blockSize 0
+    explicit BlockMatcher(size_t blockSize, HashAlgorithm strong = HashAlgorithm::MD5);
+
+    // add a block from its bytes, returns its index
+    size_t add(const uint8_t* data);
+
+    // add a block from its signature, such as one received from a peer, returns its index
+    // weak is Buzhash::hashValue of the block and digest holds HashLite::digestSize(strong) bytes
+    size_t add(uint64_t weak, const uint8_t* digest);
+
+    // matches that do not overlap, scanning resumes after each match as rsync does
+    std::vector<BlockMatch> scan(const uint8_t* data, size_t length) const;
+
+    // matches at every position, overlapping ones included
+    std::vector<BlockMatch> scanAll(const uint8_t* data, size_t length) const;
+
+    // number of known blocks
+    size_t size() const;
+
+    // bytes per block
+    size_t blockSize() const;
+
+private:
+    // bytes per block
+    size_t window;
+
+    // algorithm confirming candidates
+    HashLite strong;
+
+    // digest bytes per block
+    size_t digestLength;
+
+    // rolling hash of each block
+    std::vector<uint64_t> weakHashes;
+
+    // strong digest of each block
+    std::vector<uint8_t> digests;
+
+    // blocks by rolling hash
+    std::unordered_multimap<uint64_t, size_t> index;
+
+    // bit set of the top rolling hash bits of all blocks, most windows are rejected here without a lookup
+    std::vector<uint64_t> filter;
+
+    // shift taking a rolling hash to its filter bit
+    unsigned filterShift;
+
+    // rebuild filter once it gets crowded
+    void growFilter();
+
+    // known block whose strong digest matches a candidate window, size() if none
+    size_t confirm(const uint8_t* data, uint64_t weak, uint8_t* digest) const;
+
+    // find matches, after a match the scan resumes at the next position or after the block
+    std::vector<BlockMatch> find(const uint8_t* data, size_t length, bool overlapping) const;
+};
+
+#endif // BLOCKMATCHER_H
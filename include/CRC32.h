@@ -1,23 +1,62 @@
 #ifndef CRC32_H
 #define CRC32_H
 
+#include "CRCEngine.h"
 #include <string>
 #include <cstdint>
 
+class HashStateWriter;
+class HashStateReader;
+struct HashInput;
+
 // define CRC32 class
 class CRC32 {
 public:
+    // digest size in bytes
+    static constexpr size_t OutputSize = 4;
+
     // initialize object
     CRC32();
 
     // hash input and return checksum
     std::string hash(const std::string& input);
 
+    // hash raw bytes and write checksum as big-endian bytes
+    void hash(const uint8_t* data, size_t length, uint8_t digest[OutputSize]) const;
+
+    // checksums of many independent frames as integers, results[i] is the checksum of frames[i]
+    static void hashBatch(const HashInput* frames, size_t count, uint32_t* results);
+
+    // update running checksum
+    void update(const std::string& data);
+
+    // update running checksum with raw bytes
+    void update(const uint8_t* data, size_t length);
+
+    // update running checksum with length zero bytes without reading them, O(log length)
+    void updateZeros(uint64_t length);
+
+    // finalize and return checksum
+    std::string final();
+
+    // finalize and write checksum as big-endian bytes
+    void final(uint8_t digest[OutputSize]);
+
+    // reset running checksum
+    void reset();
+
+    // write streaming state for HashContext::serialize
+    void saveState(HashStateWriter& writer) const;
+
+    // restore streaming state written by saveState
+    void loadState(HashStateReader& reader);
+
 private:
-    // calculate checksum
-    uint32_t calculate(const std::string& data) const;
-    // define table
-    uint32_t table[256];
+    // running checksum, CRC-32/ISO-HDLC
+    CRC32ISOHDLC engine;
+
+    // format checksum as hex
+    static std::string format(uint32_t value);
 };
 
 #endif // CRC32_H
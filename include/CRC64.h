@@ -0,0 +1,81 @@
+#ifndef CRC64_H
+#define CRC64_H
+
+#include "CRCEngine.h"
+#include <string>
+#include <cstdint>
+
+class HashStateWriter;
+class HashStateReader;
+struct HashInput;
+
+// define CRC-64 variants
+enum class CRC64Variant {
+    XZ,   // CRC-64/XZ, used by xz and Go's hash/crc64 ECMA table
+    ECMA, // CRC-64/ECMA-182
+    NVMe, // CRC-64/NVME, NVMe end-to-end data protection
+};
+
+// define CRC64 class
+class CRC64 {
+public:
+    // digest size in bytes
+    static constexpr size_t OutputSize = 8;
+
+    // initialize object
+    explicit CRC64(CRC64Variant variant = CRC64Variant::XZ);
+
+    // hash input and return checksum
+    std::string hash(const std::string& input);
+
+    // hash raw bytes and write checksum as big-endian bytes
+    void hash(const uint8_t* data, size_t length, uint8_t digest[OutputSize]) const;
+
+    // checksums of many independent frames as integers, results[i] is the checksum of frames[i]
+    void hashBatch(const HashInput* frames, size_t count, uint64_t* results) const;
+
+    // update running checksum
+    void update(const std::string& data);
+
+    // update running checksum with raw bytes
+    void update(const uint8_t* data, size_t length);
+
+    // update running checksum with length zero bytes without reading them, O(log length)
+    void updateZeros(uint64_t length);
+
+    // checksum of the data so far, the running checksum is kept
+    uint64_t value() const;
+
+    // finalize and return checksum
+    std::string final();
+
+    // finalize and write checksum as big-endian bytes
+    void final(uint8_t digest[OutputSize]);
+
+    // reset running checksum
+    void reset();
+
+    // checksum of A followed by B from the checksums of A and B and the length of B
+    static uint64_t combine(CRC64Variant variant, uint64_t crcA, uint64_t crcB, uint64_t lengthB);
+
+    // write streaming state for HashContext::serialize
+    void saveState(HashStateWriter& writer) const;
+
+    // restore streaming state written by saveState
+    void loadState(HashStateReader& reader);
+
+private:
+    // selected variant
+    CRC64Variant variant;
+
+    // running checksum register
+    uint64_t crc;
+
+    // advance checksum register over data
+    uint64_t calculate(uint64_t crc, const uint8_t* data, size_t length) const;
+
+    // format checksum as hex
+    static std::string format(uint64_t value);
+};
+
+#endif // CRC64_H
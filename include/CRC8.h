@@ -1,27 +1,62 @@
 #ifndef CRC8_H
 #define CRC8_H
 
+#include "CRCEngine.h"
 #include <string>
 #include <cstdint>
 
+class HashStateWriter;
+class HashStateReader;
+struct HashInput;
+
 // Define CRC8 Class 
 class CRC8 {
 public:
+    // digest size in bytes
+    static constexpr size_t OutputSize = 1;
+
     // initialize object
     CRC8();
 
     // hash input and return checksum
     std::string hash(const std::string& input);
 
-private:
-    // calculate checksum
-    uint8_t calculate(const std::string& data) const;
+    // hash raw bytes and write checksum as big-endian bytes
+    void hash(const uint8_t* data, size_t length, uint8_t digest[OutputSize]) const;
+
+    // checksums of many independent frames as integers, results[i] is the checksum of frames[i]
+    static void hashBatch(const HashInput* frames, size_t count, uint8_t* results);
+
+    // update running checksum
+    void update(const std::string& data);
+
+    // update running checksum with raw bytes
+    void update(const uint8_t* data, size_t length);
+
+    // update running checksum with length zero bytes without reading them, O(log length)
+    void updateZeros(uint64_t length);
 
-    // define polynomial
-    static constexpr uint8_t CRC8_POLYNOMIAL = 0x7;
+    // finalize and return checksum
+    std::string final();
+
+    // finalize and write checksum as big-endian bytes
+    void final(uint8_t digest[OutputSize]);
+
+    // reset running checksum
+    void reset();
+
+    // write streaming state for HashContext::serialize
+    void saveState(HashStateWriter& writer) const;
+
+    // restore streaming state written by saveState
+    void loadState(HashStateReader& reader);
+
+private:
+    // running checksum, CRC-8/SMBUS
+    CRC8SMBus engine;
 
-    // define inital value
-    static constexpr uint8_t CRC8_INITIAL = 0x00;
+    // format checksum as hex
+    static std::string format(uint8_t value);
 };
 
 #endif // CRC8_H
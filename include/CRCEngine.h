@@ -0,0 +1,372 @@
+#ifndef CRCENGINE_H
+#define CRCENGINE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// define carry-less multiply constants for folding 16 byte blocks, [0] multiplies the low and [1] the high half
+struct CRCFoldConstants {
+    uint64_t fold16[2]; // distance of sixteen blocks
+    uint64_t fold4[2]; // distance of four blocks
+    uint64_t fold1[2]; // distance of one block
+};
+
+// define carry-less multiply fast path shared by every CRC parameter set
+class CRCFold {
+public:
+    // check if the cpu supports the fast path
+    static bool available();
+
+    // fold length bytes, a multiple of 16 and at least 16, into one block in message order
+    // prefix is xored into the first block and carries the running register
+    static void fold(const uint8_t* data, size_t length, const CRCFoldConstants& constants, bool reflected,
+                     const uint8_t prefix[16], uint8_t result[16]);
+};
+
+// checksum bits of a width
+constexpr uint64_t crcMask(unsigned width) {
+    return width == 64 ? ~0ULL : (1ULL << width) - 1;
+}
+
+// reverse low bits of value
+constexpr uint64_t crcReflect(uint64_t value, unsigned bits) {
+    uint64_t result = 0;
+    for (unsigned i = 0; i < bits; ++i) {
+        result = (result << 1) | ((value >> i) & 1);
+    }
+    return result;
+}
+
+// x^n mod poly in normal bit order
+constexpr uint64_t crcPowerMod(uint64_t poly, unsigned width, unsigned n) {
+    uint64_t result = 1;
+    for (unsigned i = 0; i < n; ++i) {
+        bool carry = (result >> (width - 1)) & 1;
+        result = (result << 1) & crcMask(width);
+        if (carry) {
+            result ^= poly & crcMask(width);
+        }
+    }
+    return result;
+}
+
+// slicing tables, entry [k][b] is the register after byte b followed by k zero bytes
+// a reflected register sits in the low bits, a normal one is aligned to the top of Value
+template <typename Value, unsigned Width, uint64_t Poly, bool Reflected>
+constexpr std::array<std::array<Value, 256>, 8> crcMakeTables() {
+    constexpr unsigned bits = 8 * sizeof(Value);
+    std::array<std::array<Value, 256>, 8> tables{};
+    for (unsigned byte = 0; byte < 256; ++byte) {
+        uint64_t reg = 0;
+        if (Reflected) {
+            uint64_t poly = crcReflect(Poly & crcMask(Width), Width);
+            reg = byte;
+            for (int bit = 0; bit < 8; ++bit) {
+                reg = reg & 1 ? (reg >> 1) ^ poly : reg >> 1;
+            }
+        } else {
+            uint64_t poly = (Poly & crcMask(Width)) << (bits - Width);
+            reg = static_cast<uint64_t>(byte) << (bits - 8);
+            for (int bit = 0; bit < 8; ++bit) {
+                reg = (reg >> (bits - 1)) & 1 ? (reg << 1) ^ poly : reg << 1;
+            }
+        }
+        tables[0][byte] = static_cast<Value>(reg);
+    }
+
+    // one more zero byte per table
+    for (size_t k = 1; k < 8; ++k) {
+        for (size_t byte = 0; byte < 256; ++byte) {
+            uint64_t reg = tables[k - 1][byte];
+            if (Reflected) {
+                reg = (reg >> 8) ^ tables[0][reg & 0xFF];
+            } else {
+                reg = (reg << 8) ^ tables[0][(reg >> (bits - 8)) & 0xFF];
+            }
+            tables[k][byte] = static_cast<Value>(reg);
+        }
+    }
+    return tables;
+}
+
+// multipliers moving a block forward by bits, reflected operands gain one factor of x in the product
+template <unsigned Width, uint64_t Poly, bool Reflected>
+constexpr void crcFoldPair(uint64_t pair[2], unsigned bits) {
+    if (Reflected) {
+        pair[0] = crcReflect(crcPowerMod(Poly, Width, bits + 63), 64);
+        pair[1] = crcReflect(crcPowerMod(Poly, Width, bits - 1), 64);
+    } else {
+        pair[0] = crcPowerMod(Poly, Width, bits);
+        pair[1] = crcPowerMod(Poly, Width, bits + 64);
+    }
+}
+
+// product of two polynomials mod poly in normal bit order
+constexpr uint64_t crcMultiplyMod(uint64_t a, uint64_t b, uint64_t poly, unsigned width) {
+    uint64_t result = 0;
+    for (int i = static_cast<int>(width) - 1; i >= 0; --i) {
+        bool carry = (result >> (width - 1)) & 1;
+        result = (result << 1) & crcMask(width);
+        if (carry) {
+            result ^= poly & crcMask(width);
+        }
+        if ((a >> i) & 1) {
+            result ^= b;
+        }
+    }
+    return result;
+}
+
+// folding constants of a polynomial
+template <unsigned Width, uint64_t Poly, bool Reflected>
+constexpr CRCFoldConstants crcMakeFoldConstants() {
+    CRCFoldConstants constants{};
+    crcFoldPair<Width, Poly, Reflected>(constants.fold16, 2048);
+    crcFoldPair<Width, Poly, Reflected>(constants.fold4, 512);
+    crcFoldPair<Width, Poly, Reflected>(constants.fold1, 128);
+    return constants;
+}
+
+// define Rocksoft model CRC, parameters follow the CRC catalogue with Poly and Init in normal bit order
+// tables and folding constants are generated at compile time for each parameter set
+template <unsigned Width, uint64_t Poly, uint64_t Init, bool RefIn, bool RefOut, uint64_t XorOut>
+class CRCEngine {
+public:
+    static_assert(Width >= 1 && Width <= 64, "CRC width must be 1 to 64 bits");
+
+    // smallest unsigned type holding a checksum
+    using Value = std::conditional_t<(Width <= 8), uint8_t,
+                  std::conditional_t<(Width <= 16), uint16_t,
+                  std::conditional_t<(Width <= 32), uint32_t, uint64_t>>>;
+
+    // digest size in bytes
+    static constexpr size_t OutputSize = (Width + 7) / 8;
+
+    // initialize running checksum
+    constexpr CRCEngine() : crc(InitialRegister) {}
+
+    // update running checksum with raw bytes
+    void update(const uint8_t* data, size_t length) {
+        crc = advance(crc, data, length);
+    }
+
+    // update running checksum with length zero bytes without reading them
+    void updateZeros(uint64_t length) {
+        crc = advanceZeros(crc, length);
+    }
+
+    // checksum of the data so far, the running state is kept
+    constexpr Value value() const {
+        return finish(crc);
+    }
+
+    // finalize and write checksum as big-endian bytes
+    void final(uint8_t digest[OutputSize]) {
+        Value result = value();
+        for (size_t i = 0; i < OutputSize; ++i) {
+            digest[i] = static_cast<uint8_t>(static_cast<uint64_t>(result) >> (8 * (OutputSize - 1 - i)));
+        }
+        reset();
+    }
+
+    // reset running checksum
+    constexpr void reset() {
+        crc = InitialRegister;
+    }
+
+    // raw register for saving streaming state
+    constexpr Value state() const {
+        return crc;
+    }
+
+    // restore raw register written by state
+    constexpr void setState(Value value) {
+        crc = value;
+    }
+
+    // compute checksum of raw bytes
+    static Value compute(const uint8_t* data, size_t length) {
+        return finish(advance(InitialRegister, data, length));
+    }
+
+    // checksums of many independent frames, Frame has data and length members like HashInput
+    // frames have no dependency on each other, so the cpu overlaps their multiply and lookup chains
+    template <typename Frame>
+    static void computeBatch(const Frame* frames, size_t count, Value* results) {
+        for (size_t i = 0; i < count; ++i) {
+            results[i] = compute(frames[i].data, frames[i].length);
+        }
+    }
+
+    // checksum of A followed by B from the checksums of A and B and the length of B
+    static Value combine(Value crcA, Value crcB, uint64_t lengthB) {
+        // registers are linear, B started from Init instead of A's register
+        Value regA = unfinish(crcA);
+        Value regB = unfinish(crcB);
+        return finish(static_cast<Value>(advanceZeros(regA, lengthB) ^ regB ^ advanceZeros(InitialRegister, lengthB)));
+    }
+
+    // register before any data, for callers that keep the raw register themselves
+    static constexpr Value initialState() {
+        return InitialRegister;
+    }
+
+    // advance a raw register over data
+    static Value advance(Value reg, const uint8_t* data, size_t length) {
+        if (length >= FoldThreshold && CRCFold::available()) {
+            // the register enters as the first bytes of the message
+            uint8_t prefix[16] = {};
+            for (size_t i = 0; i < RegisterBytes; ++i) {
+                prefix[i] = static_cast<uint8_t>(RefIn ? static_cast<uint64_t>(reg) >> (8 * i)
+                                                       : static_cast<uint64_t>(reg) >> (RegisterBits - 8 - 8 * i));
+            }
+
+            uint8_t block[16];
+            size_t folded = length & ~static_cast<size_t>(15);
+            CRCFold::fold(data, folded, FoldConstants, RefIn, prefix, block);
+            reg = slice(0, block, sizeof(block));
+            data += folded;
+            length -= folded;
+        }
+        return slice(reg, data, length);
+    }
+
+    // advance a raw register over length zero bytes in O(log length) multiplications
+    static Value advanceZeros(Value reg, uint64_t length) {
+        static constexpr std::array<uint64_t, 64> ZeroPowers = makeZeroPowers();
+
+        // the register as a polynomial in normal bit order
+        uint64_t poly = RefIn ? crcReflect(reg, Width) : static_cast<uint64_t>(reg) >> (RegisterBits - Width);
+        for (size_t k = 0; length != 0; ++k, length >>= 1) {
+            if (length & 1) {
+                poly = crcMultiplyMod(poly, ZeroPowers[k], Poly, Width);
+            }
+        }
+        return static_cast<Value>(RefIn ? crcReflect(poly, Width) : poly << (RegisterBits - Width));
+    }
+
+    // checksum of a raw register
+    static constexpr Value finish(Value reg) {
+        uint64_t result = RefIn ? reg : static_cast<uint64_t>(reg) >> (RegisterBits - Width);
+        if (RefIn != RefOut) {
+            result = crcReflect(result, Width);
+        }
+        return static_cast<Value>((result ^ XorOut) & Mask);
+    }
+
+    // checksum of "123456789", the check value listed in the CRC catalogue
+    static constexpr Value check() {
+        constexpr uint8_t digits[9] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+        return finish(slice(InitialRegister, digits, sizeof(digits)));
+    }
+
+private:
+    // bits of the register type, the register of a normal CRC is aligned to its top
+    static constexpr unsigned RegisterBits = 8 * sizeof(Value);
+
+    // bytes of the register
+    static constexpr size_t RegisterBytes = sizeof(Value);
+
+    // checksum bits
+    static constexpr uint64_t Mask = crcMask(Width);
+
+    // inputs from this size take the carry-less multiply path when available
+    // two blocks already fold faster than eight slicing steps
+    static constexpr size_t FoldThreshold = 32;
+
+    // running register
+    Value crc;
+
+    // register holding Init
+    static constexpr Value InitialRegister = RefIn ? static_cast<Value>(crcReflect(Init & Mask, Width))
+                                                   : static_cast<Value>((Init & Mask) << (RegisterBits - Width));
+
+    // raw register of a checksum, inverse of finish
+    static constexpr Value unfinish(Value value) {
+        uint64_t result = (static_cast<uint64_t>(value) ^ XorOut) & Mask;
+        if (RefIn != RefOut) {
+            result = crcReflect(result, Width);
+        }
+        return static_cast<Value>(RefIn ? result : result << (RegisterBits - Width));
+    }
+
+    // advance register by one byte
+    static constexpr Value step(const std::array<Value, 256>& table, Value reg, uint8_t byte) {
+        if (RefIn) {
+            return static_cast<Value>((static_cast<uint64_t>(reg) >> 8) ^ table[(reg ^ byte) & 0xFF]);
+        }
+        return static_cast<Value>((static_cast<uint64_t>(reg) << 8) ^
+                                  table[((static_cast<uint64_t>(reg) >> (RegisterBits - 8)) ^ byte) & 0xFF]);
+    }
+
+    // slicing tables
+    static constexpr std::array<std::array<Value, 256>, 8> Tables = crcMakeTables<Value, Width, Poly, RefIn>();
+
+    // advance register over data, eight bytes per step
+    static constexpr Value slice(Value reg, const uint8_t* data, size_t length) {
+        while (length >= 8) {
+            // the register overlaps the first bytes of the word
+            uint64_t word = 0;
+            if (RefIn) {
+                for (int i = 7; i >= 0; --i) {
+                    word = (word << 8) | data[i];
+                }
+                word ^= reg;
+            } else {
+                for (int i = 0; i < 8; ++i) {
+                    word = (word << 8) | data[i];
+                }
+                word ^= static_cast<uint64_t>(reg) << (64 - RegisterBits);
+            }
+
+            uint64_t next = 0;
+            for (int i = 0; i < 8; ++i) {
+                uint8_t byte = static_cast<uint8_t>(RefIn ? word >> (8 * i) : word >> (56 - 8 * i));
+                next ^= Tables[7 - i][byte];
+            }
+            reg = static_cast<Value>(next);
+            data += 8;
+            length -= 8;
+        }
+
+        // tail
+        for (size_t i = 0; i < length; ++i) {
+            reg = step(Tables[0], reg, data[i]);
+        }
+        return reg;
+    }
+
+    // folding constants
+    static constexpr CRCFoldConstants FoldConstants = crcMakeFoldConstants<Width, Poly, RefIn>();
+
+    // x^(8 * 2^k) mod Poly, the effect of 2^k zero bytes on the register
+    static constexpr std::array<uint64_t, 64> makeZeroPowers() {
+        std::array<uint64_t, 64> powers{};
+        powers[0] = crcPowerMod(Poly, Width, 8);
+        for (size_t k = 1; k < 64; ++k) {
+            powers[k] = crcMultiplyMod(powers[k - 1], powers[k - 1], Poly, Width);
+        }
+        return powers;
+    }
+
+};
+
+// common parameter sets from the CRC catalogue
+using CRC8SMBus = CRCEngine<8, 0x07, 0x00, false, false, 0x00>;
+using CRC8Maxim = CRCEngine<8, 0x31, 0x00, true, true, 0x00>;
+using CRC16XModem = CRCEngine<16, 0x1021, 0x0000, false, false, 0x0000>;
+using CRC16IBM3740 = CRCEngine<16, 0x1021, 0xFFFF, false, false, 0x0000>;
+using CRC16Kermit = CRCEngine<16, 0x1021, 0x0000, true, true, 0x0000>;
+using CRC16Modbus = CRCEngine<16, 0x8005, 0xFFFF, true, true, 0x0000>;
+using CRC16ARC = CRCEngine<16, 0x8005, 0x0000, true, true, 0x0000>;
+using CRC32ISOHDLC = CRCEngine<32, 0x04C11DB7, 0xFFFFFFFF, true, true, 0xFFFFFFFF>;
+using CRC32BZip2 = CRCEngine<32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0xFFFFFFFF>;
+using CRC32MPEG2 = CRCEngine<32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0x00000000>;
+using CRC32C = CRCEngine<32, 0x1EDC6F41, 0xFFFFFFFF, true, true, 0xFFFFFFFF>;
+using CRC64XZ = CRCEngine<64, 0x42F0E1EBA9EA3693ULL, ~0ULL, true, true, ~0ULL>;
+using CRC64ECMA = CRCEngine<64, 0x42F0E1EBA9EA3693ULL, 0, false, false, 0>;
+using CRC64NVMe = CRCEngine<64, 0xAD93D23594C93659ULL, ~0ULL, true, true, ~0ULL>;
+
+#endif // CRCENGINE_H
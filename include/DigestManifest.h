@@ -0,0 +1,122 @@
+#ifndef DIGESTMANIFEST_H
+#define DIGESTMANIFEST_H
+
+#include "HashLite.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// define binary manifest builder, entries are sorted when written
+class DigestManifestWriter {
+public:
+    // initialize empty manifest for digests of an algorithm
+    explicit DigestManifestWriter(HashAlgorithm algorithm);
+
+    // add entry, digest holds HashLite::digestSize(algorithm) bytes, a later entry for the same path replaces it
+    void add(const std::string& path, const uint8_t* digest);
+
+    // read a sha256sum style text manifest, "<hex>  <path>" or "<hex> *<path>" per line
+    void addText(const std::string& textPath);
+
+    // number of entries added
+    size_t size() const;
+
+    // write manifest, the file is replaced atomically
+    // layout: header, records sorted by path, record numbers sorted by digest, digest prefix index, path strings
+    void write(const std::string& path) const;
+
+private:
+    // manifest algorithm
+    HashAlgorithm algorithm;
+
+    // digest bytes per entry
+    size_t digestSize;
+
+    // entry paths in insertion order
+    std::vector<std::string> paths;
+
+    // entry digests in insertion order
+    std::vector<uint8_t> digests;
+};
+
+// define read-only view of a binary manifest, mapped without parsing
+class DigestManifest {
+public:
+    // entry number returned by find when nothing matches
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    // map manifest, throws runtime_error on unreadable or malformed files
+    explicit DigestManifest(const std::string& path);
+
+    // unmap manifest
+    ~DigestManifest();
+
+    DigestManifest(const DigestManifest&) = delete;
+    DigestManifest& operator=(const DigestManifest&) = delete;
+
+    // algorithm of the digests
+    HashAlgorithm algorithm() const;
+
+    // digest bytes per entry
+    size_t digestSize() const;
+
+    // number of entries
+    size_t size() const;
+
+    // path of entry i, entries are in byte order of their paths
+    std::string_view path(size_t i) const;
+
+    // digest of entry i, digestSize() bytes inside the mapping
+    const uint8_t* digest(size_t i) const;
+
+    // entry with this path in O(log n), npos if absent
+    size_t find(std::string_view path) const;
+
+    // entries with this digest, found through the prefix index and a binary search within its bucket
+    std::vector<size_t> findDigest(const uint8_t* digest) const;
+
+    // write entries as a sha256sum style text manifest with lowercase hex
+    void writeText(const std::string& textPath) const;
+
+    // hash every listed file on the shared pool and compare with its digest
+    // bit i % 64 of failures[i / 64] is set when entry i does not match, returns the number of failures
+    size_t verify(uint64_t* failures) const;
+
+private:
+    // manifest bytes
+    const uint8_t* data;
+
+    // manifest length
+    size_t length;
+
+    // file contents on platforms without mmap
+    std::vector<uint8_t> buffer;
+
+    // whether data is a mapping to release
+    bool mapped;
+
+    // bytes per record
+    size_t recordSize;
+
+    // digest bytes per entry
+    size_t digestLength;
+
+    // number of entries
+    size_t count;
+
+    // section offsets
+    uint64_t digestOrder;
+    uint64_t prefixIndex;
+    uint64_t strings;
+    uint64_t stringsSize;
+
+    // digest prefix bits used by the prefix index
+    unsigned prefixBits;
+
+    // record of entry i
+    const uint8_t* record(size_t i) const;
+};
+
+#endif // DIGESTMANIFEST_H
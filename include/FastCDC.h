@@ -0,0 +1,81 @@
+#ifndef FASTCDC_H
+#define FASTCDC_H
+
+#include "HashLite.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+class ThreadPool;
+
+// define chunk size limits
+struct FastCDCOptions {
+    // no boundary before this many bytes, at least 64
+    size_t minSize = 2048;
+
+    // target average, a power of two from 256
+    size_t avgSize = 8192;
+
+    // forced boundary after this many bytes, at least avgSize
+    size_t maxSize = 65536;
+
+    // normalization level, mask bits added before avgSize and removed after it, 0 to 3
+    unsigned normalization = 2;
+};
+
+// define one chunk of an input
+struct ContentChunk {
+    uint64_t offset = 0;         // position in the input
+    size_t length = 0;           // chunk bytes
+    std::vector<uint8_t> digest; // digest of the chunk bytes
+};
+
+// receives chunks in input order together with their bytes
+using ChunkCallback = std::function<void(const ContentChunk& chunk, const uint8_t* data)>;
+
+// define FastCDC content-defined chunking with a gear rolling hash and normalized chunking
+// a boundary depends only on the 64 bytes before it, so an edit moves the boundaries near it and no others
+// the gear table and masks are fixed, the same input and options always give the same chunks
+class FastCDC {
+public:
+    // initialize chunker, throws runtime_error for invalid options
+    explicit FastCDC(const FastCDCOptions& options = FastCDCOptions());
+
+    // length of the first chunk of data, length itself when data ends before a boundary and maxSize
+    size_t cut(const uint8_t* data, size_t length) const;
+
+    // chunk boundaries of a whole input, digests are left empty
+    std::vector<ContentChunk> boundaries(const uint8_t* data, size_t length) const;
+
+    // chunk an input and digest the chunks on the shared pool
+    std::vector<ContentChunk> split(HashAlgorithm algorithm, const uint8_t* data, size_t length) const;
+
+    // chunk an input and digest the chunks on the given pool
+    std::vector<ContentChunk> split(HashAlgorithm algorithm, const uint8_t* data, size_t length,
+                                    ThreadPool& pool) const;
+
+    // chunk a stream, source fills up to capacity bytes and returns the count, 0 at end of input
+    // chunks are digested on the shared pool a buffer at a time and passed to onChunk in order
+    void splitStream(HashAlgorithm algorithm, const std::function<size_t(uint8_t* buffer, size_t capacity)>& source,
+                     const ChunkCallback& onChunk) const;
+
+    // chunk a file, read in buffers without loading the whole file
+    void splitFile(HashAlgorithm algorithm, const std::string& path, const ChunkCallback& onChunk) const;
+
+    // options in use
+    const FastCDCOptions& options() const;
+
+private:
+    // size limits
+    FastCDCOptions limits;
+
+    // stricter mask used before avgSize
+    uint64_t maskSmall;
+
+    // looser mask used after avgSize
+    uint64_t maskLarge;
+};
+
+#endif // FASTCDC_H
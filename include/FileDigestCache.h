@@ -0,0 +1,91 @@
+#ifndef FILEDIGESTCACHE_H
+#define FILEDIGESTCACHE_H
+
+#include "HashLite.h"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+// define cache counters
+struct FileDigestCacheStats {
+    uint64_t hits = 0;    // digests returned from the cache
+    uint64_t misses = 0;  // files hashed because they were missing or changed
+    uint64_t stores = 0;  // digests written to the cache
+};
+
+// define persistent file digest cache, (device, inode, size, mtime_ns, algorithm) -> digest
+// the cache file is a memory-mapped open addressing table of fixed-size records, each record carries a CRC-32
+// so a record torn by a crash reads as a miss, growing rewrites the table into a new file and renames it over
+// the old one, and writers in different processes take an exclusive lock on the file
+// on Windows nothing is persisted and every lookup hashes the file
+class FileDigestCache {
+public:
+    // open cache file, created if missing and recreated empty if corrupt or from another version
+    explicit FileDigestCache(const std::string& path);
+
+    // unmap and close cache file
+    ~FileDigestCache();
+
+    FileDigestCache(const FileDigestCache&) = delete;
+    FileDigestCache& operator=(const FileDigestCache&) = delete;
+
+    // digest of a file, from the cache when the file is unchanged, otherwise hashed and stored
+    // writes HashLite::digestSize(algorithm) bytes, throws runtime_error when the file cannot be read
+    // a cache that cannot be locked or written leaves the digest uncached
+    void fileDigest(HashAlgorithm algorithm, const std::string& path, uint8_t* digest);
+
+    // drop all records, throws runtime_error when the cache cannot be locked
+    void clear();
+
+    // number of records in the cache
+    size_t size() const;
+
+    // counters since this object was opened
+    FileDigestCacheStats stats() const;
+
+private:
+    // cache file path
+    std::string cachePath;
+
+    // open cache file, -1 when not persisted
+    int fd;
+
+    // mapped table, header followed by records
+    uint8_t* mapping;
+
+    // mapped bytes
+    size_t mappingSize;
+
+    // guards the mapping and counters
+    mutable std::mutex mutex;
+
+    // counters
+    FileDigestCacheStats counters;
+
+    // map the file behind fd, recreate it when it is not a valid table
+    void map();
+
+    // unmap and close
+    void unmap();
+
+    // reopen if another process replaced the file while growing it, caller holds the file lock
+    // returns false when the new file cannot be locked or mapped, the current table is kept then
+    bool reopenIfReplaced();
+
+    // write a fresh empty table with slots records to fd
+    void initialize(int file, uint64_t slots);
+
+    // rewrite the table with twice the slots into a new file and rename it over the old one
+    void grow();
+
+    // look up a record, returns true and fills digest when it matches size and mtime
+    bool lookup(uint64_t device, uint64_t inode, uint64_t size, int64_t mtime, HashAlgorithm algorithm,
+                uint8_t* digest) const;
+
+    // insert or replace a record, caller holds the file lock
+    void store(uint64_t device, uint64_t inode, uint64_t size, int64_t mtime, HashAlgorithm algorithm,
+               const uint8_t* digest, size_t length);
+};
+
+#endif // FILEDIGESTCACHE_H
@@ -0,0 +1,25 @@
+#ifndef HKDF_H
+#define HKDF_H
+
+#include "HashLite.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// define extract-and-expand key derivation (RFC 5869) over HMAC
+class HKDF {
+public:
+    // extract pseudorandom key from input key material, writes digest size bytes into prk
+    static void extract(HashAlgorithm algorithm, const uint8_t* salt, size_t saltLength,
+                        const uint8_t* ikm, size_t ikmLength, uint8_t* prk);
+
+    // expand pseudorandom key into outputLength bytes, at most 255 digests
+    static void expand(HashAlgorithm algorithm, const uint8_t* prk, size_t prkLength,
+                       const uint8_t* info, size_t infoLength, uint8_t* output, size_t outputLength);
+
+    // extract then expand
+    static std::vector<uint8_t> derive(HashAlgorithm algorithm, const std::string& ikm, const std::string& salt,
+                                       const std::string& info, size_t outputLength);
+};
+
+#endif // HKDF_H
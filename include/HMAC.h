@@ -0,0 +1,50 @@
+#ifndef HMAC_H
+#define HMAC_H
+
+#include "HashContext.h"
+#include <string>
+#include <cstdint>
+
+// define keyed hash (RFC 2104) for SHA-1, SHA-2 and MD5
+// the key pads are absorbed once, each message copies the cached inner and outer states
+class HMAC {
+public:
+    // initialize with key
+    HMAC(HashAlgorithm algorithm, const std::string& key);
+
+    // initialize with raw key bytes
+    HMAC(HashAlgorithm algorithm, const uint8_t* key, size_t keyLength);
+
+    // compute tag and return it as hex
+    std::string compute(const std::string& message) const;
+
+    // compute tag of raw bytes, writes digestSize() bytes
+    void compute(const uint8_t* data, size_t length, uint8_t* tag) const;
+
+    // compare tag of message against expected tag in constant time
+    bool verify(const uint8_t* data, size_t length, const uint8_t* expected, size_t expectedLength) const;
+
+    // compare tag of message against expected tag in constant time
+    bool verify(const std::string& message, const std::string& expected) const;
+
+    // tag size in bytes
+    size_t digestSize() const;
+
+    // input block size of an algorithm, throws for algorithms without HMAC support
+    static size_t blockSize(HashAlgorithm algorithm);
+
+    // compare two byte arrays without stopping at the first difference
+    static bool constantTimeEqual(const uint8_t* a, const uint8_t* b, size_t length);
+
+private:
+    // hash state after absorbing key ^ ipad
+    HashContext inner;
+
+    // hash state after absorbing key ^ opad
+    HashContext outer;
+
+    // finish tag from a hash state that already absorbed the message
+    void finish(HashContext& message, uint8_t* tag) const;
+};
+
+#endif // HMAC_H
@@ -0,0 +1,104 @@
+#ifndef HASHCONTEXT_H
+#define HASHCONTEXT_H
+
+#include "HashLite.h"
+#include "SHA256.h"
+#include "MD5.h"
+#include "CRC32.h"
+#include "CRC8.h"
+#include "CRC16.h"
+#include "CRC64.h"
+#include "SHA1.h"
+#include "SHA224.h"
+#include "SHA384.h"
+#include "SHA512.h"
+#include "BLAKE3.h"
+#include "XXH64.h"
+#include "XXH3.h"
+#include "XXH128.h"
+#include "SHA3.h"
+#include "SHAKE.h"
+#include "SHA512_256.h"
+#include "SHA512_224.h"
+#include <string>
+#include <variant>
+#include <vector>
+#include <cstdint>
+
+#ifndef _WIN32
+#include <sys/uio.h>
+#endif
+
+class ThreadPool;
+
+// define streaming hash context for any algorithm
+class HashContext {
+public:
+    // initialize context with selected algorithm
+    explicit HashContext(HashAlgorithm algorithm);
+
+    // feed data
+    void update(const std::string& data);
+
+    // feed raw bytes
+    void update(const uint8_t* data, size_t length);
+
+    // feed non-contiguous segments in order, full blocks are hashed in place from each segment
+    void update(const HashInput* segments, size_t count);
+
+#ifndef _WIN32
+    // feed a POSIX scatter-gather list in order
+    void update(const struct iovec* segments, int count);
+#endif
+
+    // feed length zero bytes, CRCs advance in O(log length) without touching memory
+    void updateZeros(uint64_t length);
+
+    // finalize and return hash in the same format as HashLite::computeHash, context is reset
+    std::string final();
+
+    // finalize and write digestSize() bytes into digest, context is reset
+    void final(uint8_t* digest);
+
+    // discard fed data
+    void reset();
+
+    // copy of the current state, including the buffered partial block
+    // a shared prefix is compressed once and each clone only pays for its own suffix
+    HashContext clone() const;
+
+    // write digest of everything fed so far followed by suffix, this context is left unchanged
+    void finalWith(const uint8_t* suffix, size_t length, uint8_t* digest) const;
+
+    // finalize each suffix on its own clone of this context on the shared pool
+    // digest i is written at digests + i * digestSize()
+    void finalBatch(const HashInput* suffixes, size_t count, uint8_t* digests) const;
+
+    // finalize each suffix on the given pool
+    void finalBatch(const HashInput* suffixes, size_t count, uint8_t* digests, ThreadPool& pool) const;
+
+    // save running state as a versioned binary record that deserialize accepts in any process
+    // layout: "HLSC", version, algorithm id, chaining values, bit count, buffered tail, CRC32 of the record
+    std::vector<uint8_t> serialize() const;
+
+    // resume from a serialize record, throws runtime_error on malformed, corrupt or unknown records
+    static HashContext deserialize(const uint8_t* data, size_t length);
+
+    // resume from a serialize record
+    static HashContext deserialize(const std::vector<uint8_t>& record);
+
+    // selected algorithm
+    HashAlgorithm algorithm() const;
+
+    // binary digest size of the selected algorithm
+    size_t digestSize() const;
+
+private:
+    // selected algorithm
+    HashAlgorithm selected;
+
+    // algorithm state
+    std::variant<SHA256, MD5, CRC32, CRC8, CRC16, SHA1, SHA224, SHA384, SHA512, BLAKE3, XXH64, XXH3, XXH128, SHA3, SHAKE, SHA512_256, SHA512_224, CRC64> engine;
+};
+
+#endif // HASHCONTEXT_H
@@ -0,0 +1,224 @@
+#ifndef HASHEXECUTOR_H
+#define HASHEXECUTOR_H
+
+#include "HashLite.h"
+#include "HashContext.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#include <coroutine>
+#define HASHLITE_HAS_COROUTINES 1
+#endif
+
+class ThreadPool;
+
+// define cancellation token, copies share the same flag
+class CancellationToken {
+public:
+    // initialize token in the not cancelled state
+    CancellationToken();
+
+    // request cancellation
+    void cancel();
+
+    // check if cancellation was requested
+    bool cancelled() const;
+
+private:
+    // shared flag
+    std::shared_ptr<std::atomic<bool>> flag;
+};
+
+// error stored in the future of a cancelled request
+class HashCancelled : public std::runtime_error {
+public:
+    HashCancelled() : std::runtime_error("Hash request cancelled") {}
+};
+
+// completion callback, error is null on success
+using HashCallback = std::function<void(std::exception_ptr error, const std::vector<uint8_t>& digest)>;
+
+// streamed input, fills up to capacity bytes and returns the count, 0 at end of input
+using HashSource = std::function<size_t(uint8_t* buffer, size_t capacity)>;
+
+// define scheduling lanes
+enum class HashPriority {
+    Auto,    // priority lane below batchThreshold, bulk lane otherwise
+    Latency, // always priority lane
+    Bulk,    // always bulk lane
+};
+
+// define executor options
+struct HashExecutorOptions {
+    // inputs smaller than this go to the priority lane and are grouped into batches
+    size_t batchThreshold = 4096;
+
+    // most requests run by one batch
+    size_t maxBatch = 256;
+
+    // bytes a bulk job hashes per task before yielding to other queued work
+    size_t chunkSize = 1 << 20;
+};
+
+// define per lane scheduling metrics
+struct HashLaneStats {
+    size_t queueDepth = 0;                   // requests waiting to start
+    uint64_t started = 0;                    // requests that left the queue
+    std::chrono::nanoseconds totalWait{0};   // summed time from queueing to start
+    std::chrono::nanoseconds maxWait{0};     // longest time from queueing to start
+};
+
+// define executor metrics
+struct HashExecutorStats {
+    HashLaneStats priority; // small and latency sensitive requests
+    HashLaneStats bulk;     // chunked large jobs
+};
+
+// define asynchronous hashing executor
+// small requests run from a priority lane, large jobs are hashed chunkSize bytes per task and
+// requeued behind other bulk jobs, so a small request waits at most about one chunk per worker
+class HashExecutor {
+public:
+    // initialize executor on a thread pool
+    explicit HashExecutor(ThreadPool& pool, const HashExecutorOptions& options = HashExecutorOptions());
+
+    // initialize executor on the shared thread pool
+    HashExecutor();
+
+    // wait for outstanding requests
+    ~HashExecutor();
+
+    HashExecutor(const HashExecutor&) = delete;
+    HashExecutor& operator=(const HashExecutor&) = delete;
+
+    // queue input for hashing, onComplete runs on a worker thread before the future is ready and must not throw
+    std::future<std::vector<uint8_t>> hashAsync(HashAlgorithm algorithm, std::string input,
+                                                 HashCallback onComplete = nullptr,
+                                                 CancellationToken token = CancellationToken(),
+                                                 HashPriority priority = HashPriority::Auto);
+
+    // queue streamed input in the bulk lane, source is called from one worker at a time
+    std::future<std::vector<uint8_t>> hashAsync(HashAlgorithm algorithm, HashSource source,
+                                                 HashCallback onComplete = nullptr,
+                                                 CancellationToken token = CancellationToken());
+
+    // snapshot of queue depth and wait time metrics
+    HashExecutorStats stats() const;
+
+    // process wide executor on the shared thread pool
+    static HashExecutor& shared();
+
+private:
+    // queued request
+    struct Request {
+        HashAlgorithm algorithm;
+        std::string input;                        // in memory input
+        HashSource source;                        // streamed input, empty for in memory input
+        std::optional<HashContext> context;       // running state of a bulk job
+        size_t offset = 0;                        // bytes of input hashed so far
+        std::vector<uint8_t> chunk;               // read buffer for streamed input
+        std::promise<std::vector<uint8_t>> promise;
+        HashCallback callback;
+        CancellationToken token;
+        std::chrono::steady_clock::time_point queued; // time the request entered its lane
+        bool started = false;                     // left the queue at least once
+    };
+
+    // worker pool
+    ThreadPool& pool;
+
+    // executor options
+    HashExecutorOptions options;
+
+    // scheduling lanes and metrics
+    mutable std::mutex queueMutex;
+    std::deque<std::shared_ptr<Request>> priorityLane;
+    std::deque<std::shared_ptr<Request>> bulkLane;
+    HashExecutorStats metrics;
+
+    // pool tasks not finished yet
+    std::mutex tokenMutex;
+    std::condition_variable idle;
+    size_t tokens;
+
+    // queue request in a lane
+    void enqueue(const std::shared_ptr<Request>& request, bool urgent);
+
+    // submit a pool task that runs the next unit of work
+    void schedule();
+
+    // run a priority batch or one bulk chunk
+    void runNext();
+
+    // hash a batch of small requests
+    void runBatch(std::vector<std::shared_ptr<Request>>& requests);
+
+    // hash one chunk of a bulk job, returns true once the job is complete
+    bool runChunk(Request& job);
+
+    // set result and run callback
+    void complete(Request& request, std::exception_ptr error, const std::vector<uint8_t>& digest);
+};
+
+#ifdef HASHLITE_HAS_COROUTINES
+// define awaitable hash, co_await resumes on a worker thread with the digest
+class HashAwaitable {
+public:
+    // initialize awaitable
+    HashAwaitable(HashExecutor& executor, HashAlgorithm algorithm, std::string input,
+                  CancellationToken token = CancellationToken())
+        : executor(executor), algorithm(algorithm), input(std::move(input)), token(std::move(token)) {}
+
+    // always hand the work to the executor
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    // queue request and resume the coroutine on completion
+    void await_suspend(std::coroutine_handle<> handle) {
+        executor.hashAsync(algorithm, std::move(input),
+            [this, handle](std::exception_ptr failure, const std::vector<uint8_t>& result) {
+                error = failure;
+                digest = result;
+                handle.resume();
+            }, token);
+    }
+
+    // return digest or rethrow failure
+    std::vector<uint8_t> await_resume() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return std::move(digest);
+    }
+
+private:
+    HashExecutor& executor;
+    HashAlgorithm algorithm;
+    std::string input;
+    CancellationToken token;
+    std::vector<uint8_t> digest;
+    std::exception_ptr error;
+};
+
+// create awaitable hash on the shared executor
+inline HashAwaitable hashAwait(HashAlgorithm algorithm, std::string input,
+                               CancellationToken token = CancellationToken()) {
+    return HashAwaitable(HashExecutor::shared(), algorithm, std::move(input), std::move(token));
+}
+#endif
+
+#endif // HASHEXECUTOR_H
@@ -2,8 +2,13 @@
 #define HASHLITE_H
 
 #include <string>
+#include <vector>
+#include <cstddef>
 #include <cstdint>
 
+class ThreadPool;
+class FileDigestCache;
+
 // define available algorithms
 enum class HashAlgorithm {
     SHA256,    // SHA-256 algorithm
@@ -15,6 +20,27 @@ enum class HashAlgorithm {
     SHA224,    // SHA-224 algorithm
     SHA384,    // SHA-384 algorithm
     SHA512,    // SHA-512 algorithm
+    BLAKE3,    // BLAKE3 algorithm
+    XXH64,     // XXH64 algorithm
+    XXH3,      // XXH3 algorithm, 64-bit output
+    XXH128,    // XXH3 algorithm, 128-bit output
+    SHA3_224,  // SHA3-224 algorithm
+    SHA3_256,  // SHA3-256 algorithm
+    SHA3_384,  // SHA3-384 algorithm
+    SHA3_512,  // SHA3-512 algorithm
+    SHAKE128,  // SHAKE128 algorithm, 32 bytes of output
+    SHAKE256,  // SHAKE256 algorithm, 64 bytes of output
+    SHA512_256, // SHA-512/256 algorithm
+    SHA512_224, // SHA-512/224 algorithm
+    CRC64,     // CRC-64/XZ algorithm
+    CRC64_ECMA, // CRC-64/ECMA-182 algorithm
+    CRC64_NVME, // CRC-64/NVME algorithm
+};
+
+// define one input of a batch
+struct HashInput {
+    const uint8_t* data; // input bytes
+    size_t length;       // number of bytes
 };
 
 // define class
@@ -26,6 +52,52 @@ public:
     // compute and return hash of the input using selected algorithm
     std::string computeHash(const std::string& input);
 
+    // compute binary hash of the input, writes digestSize() bytes
+    void computeDigest(const uint8_t* data, size_t length, uint8_t* digest) const;
+
+    // compute binary hash of count segments hashed as one message, without joining them
+    void computeDigest(const HashInput* segments, size_t count, uint8_t* digest) const;
+
+    // compute hash of a file, read in chunks without loading the whole file
+    std::string computeFileHash(const std::string& path) const;
+
+    // compute binary hash of a file, writes digestSize() bytes
+    void computeFileDigest(const std::string& path, uint8_t* digest) const;
+
+    // compute binary hash of a file, reusing the digest cached for an unchanged file
+    void computeFileDigest(const std::string& path, uint8_t* digest, FileDigestCache& cache) const;
+
+    // hash count inputs across the shared thread pool, digest i is written at digests + i * digestSize()
+    void computeBatch(const HashInput* inputs, size_t count, uint8_t* digests) const;
+
+    // hash count inputs across the given thread pool
+    void computeBatch(const HashInput* inputs, size_t count, uint8_t* digests, ThreadPool& pool) const;
+
+    // hash strings across the shared thread pool
+    void computeBatch(const std::vector<std::string>& inputs, uint8_t* digests) const;
+
+    // hash count inputs across the shared thread pool and compare digest i with expected + i * digestSize()
+    // in constant time, bit i % 64 of failures[i / 64] is set when input i does not match
+    // failures holds (count + 63) / 64 words, returns the number of failures
+    size_t verifyBatch(const HashInput* inputs, const uint8_t* expected, size_t count, uint64_t* failures) const;
+
+    // verify count inputs across the given thread pool
+    size_t verifyBatch(const HashInput* inputs, const uint8_t* expected, size_t count, uint64_t* failures,
+                       ThreadPool& pool) const;
+
+    // verify files across the shared thread pool, files that cannot be read count as failures
+    size_t verifyFiles(const std::vector<std::string>& paths, const uint8_t* expected, uint64_t* failures) const;
+
+    // verify files across the given thread pool
+    size_t verifyFiles(const std::vector<std::string>& paths, const uint8_t* expected, uint64_t* failures,
+                       ThreadPool& pool) const;
+
+    // binary digest size of the selected algorithm
+    size_t digestSize() const;
+
+    // binary digest size of an algorithm
+    static size_t digestSize(HashAlgorithm algorithm);
+
 private:
     // return selected algorithm  
     HashAlgorithm algorithm;
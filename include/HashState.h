@@ -0,0 +1,75 @@
+#ifndef HASHSTATE_H
+#define HASHSTATE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+// define big-endian writer for serialized hash state
+class HashStateWriter {
+public:
+    // append to out
+    explicit HashStateWriter(std::vector<uint8_t>& out);
+
+    // append the low bytes of value, most significant first
+    void putWord(uint64_t value, size_t bytes);
+
+    // append raw bytes
+    void putBytes(const uint8_t* data, size_t length);
+
+private:
+    // output record
+    std::vector<uint8_t>& out;
+};
+
+// define big-endian reader for serialized hash state, throws runtime_error past the end
+class HashStateReader {
+public:
+    // read from data
+    HashStateReader(const uint8_t* data, size_t length);
+
+    // read a bytes wide big-endian value
+    uint64_t getWord(size_t bytes);
+
+    // read raw bytes
+    void getBytes(uint8_t* data, size_t length);
+
+    // bytes not read yet
+    size_t remaining() const;
+
+private:
+    // input record
+    const uint8_t* data;
+    size_t length;
+    size_t offset;
+};
+
+// write chaining values, bit count and buffered tail of a block hash
+template <typename Word, size_t Words>
+void saveBlockState(HashStateWriter& writer, const Word (&state)[Words], uint64_t bitCount,
+                    const uint8_t* buffer, size_t bufferIndex) {
+    for (size_t i = 0; i < Words; ++i) {
+        writer.putWord(state[i], sizeof(Word));
+    }
+    writer.putWord(bitCount, 8);
+    writer.putWord(bufferIndex, 1);
+    writer.putBytes(buffer, bufferIndex);
+}
+
+// read state written by saveBlockState, the tail must match the bit count
+template <typename Word, size_t Words>
+void loadBlockState(HashStateReader& reader, Word (&state)[Words], uint64_t& bitCount,
+                    uint8_t* buffer, size_t& bufferIndex, size_t blockSize) {
+    for (size_t i = 0; i < Words; ++i) {
+        state[i] = static_cast<Word>(reader.getWord(sizeof(Word)));
+    }
+    bitCount = reader.getWord(8);
+    bufferIndex = static_cast<size_t>(reader.getWord(1));
+    if (bitCount % 8 != 0 || bufferIndex != (bitCount / 8) % blockSize) {
+        throw std::runtime_error("Invalid hash state");
+    }
+    reader.getBytes(buffer, bufferIndex);
+}
+
+#endif // HASHSTATE_H
@@ -0,0 +1,124 @@
+#ifndef HASHSTREAM_H
+#define HASHSTREAM_H
+
+#include "HashContext.h"
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// define output stream buffer that hashes bytes as they are written to another stream buffer
+class HashOStreamBuf : public std::streambuf {
+public:
+    // initialize buffer, data is forwarded to target in chunks of bufferSize bytes
+    HashOStreamBuf(std::streambuf* target, HashAlgorithm algorithm, size_t bufferSize = 1 << 16);
+
+    // forward buffered data
+    ~HashOStreamBuf() override;
+
+    // flush and return hash of everything written so far, hashing restarts afterwards
+    std::string final();
+
+    // flush and write binary hash of everything written so far
+    void final(uint8_t* digest);
+
+protected:
+    // flush full buffer and store c
+    int_type overflow(int_type c) override;
+
+    // write block, large blocks bypass the buffer
+    std::streamsize xsputn(const char* data, std::streamsize count) override;
+
+    // flush buffer and target
+    int sync() override;
+
+private:
+    // wrapped stream buffer
+    std::streambuf* target;
+
+    // running hash
+    HashContext context;
+
+    // put area
+    std::vector<char> buffer;
+
+    // hash and forward the put area
+    bool flushBuffer();
+
+    // forward a block and hash the bytes the target accepted, returns their count
+    std::streamsize forward(const char* data, std::streamsize count);
+};
+
+// define input stream buffer that hashes bytes as they are read from another stream buffer
+class HashIStreamBuf : public std::streambuf {
+public:
+    // initialize buffer, data is read from source in chunks of bufferSize bytes
+    HashIStreamBuf(std::streambuf* source, HashAlgorithm algorithm, size_t bufferSize = 1 << 16);
+
+    // return hash of everything consumed so far, hashing restarts afterwards
+    std::string final();
+
+    // write binary hash of everything consumed so far
+    void final(uint8_t* digest);
+
+protected:
+    // refill buffer from source
+    int_type underflow() override;
+
+    // read block, large blocks bypass the buffer
+    std::streamsize xsgetn(char* data, std::streamsize count) override;
+
+private:
+    // wrapped stream buffer
+    std::streambuf* source;
+
+    // running hash
+    HashContext context;
+
+    // get area
+    std::vector<char> buffer;
+
+    // hash consumed part of the get area not hashed yet
+    void hashConsumed();
+
+    // start of the get area bytes not hashed yet
+    char* hashedUpTo;
+};
+
+// define output stream that hashes everything written to target
+class HashOStream : public std::ostream {
+public:
+    // initialize stream
+    HashOStream(std::ostream& target, HashAlgorithm algorithm, size_t bufferSize = 1 << 16);
+
+    // flush and return hash of everything written
+    std::string final();
+
+    // flush and write binary hash of everything written
+    void final(uint8_t* digest);
+
+private:
+    // hashing buffer
+    HashOStreamBuf buf;
+};
+
+// define input stream that hashes everything read from source
+class HashIStream : public std::istream {
+public:
+    // initialize stream
+    HashIStream(std::istream& source, HashAlgorithm algorithm, size_t bufferSize = 1 << 16);
+
+    // return hash of everything read
+    std::string final();
+
+    // write binary hash of everything read
+    void final(uint8_t* digest);
+
+private:
+    // hashing buffer
+    HashIStreamBuf buf;
+};
+
+#endif // HASHSTREAM_H
@@ -0,0 +1,54 @@
+#ifndef KECCAK_H
+#define KECCAK_H
+
+#include <cstddef>
+#include <cstdint>
+
+class HashStateWriter;
+class HashStateReader;
+
+// define Keccak sponge shared by SHA-3 and SHAKE
+class Keccak {
+public:
+    // initialize sponge, rate in bytes, suffix holds the domain bits followed by the first padding bit
+    Keccak(size_t rate, uint8_t suffix);
+
+    // absorb data, throws once squeezing has started
+    void absorb(const uint8_t* data, size_t length);
+
+    // squeeze output, the first call pads and ends absorbing
+    void squeeze(uint8_t* output, size_t length);
+
+    // reset to the empty state
+    void reset();
+
+    // write sponge state in canonical lane order for HashContext::serialize
+    void saveState(HashStateWriter& writer) const;
+
+    // restore sponge state written by saveState, the rate and suffix must match
+    void loadState(HashStateReader& reader);
+
+    // apply Keccak-f[1600] to a state kept in lane-complemented form
+    static void permute(uint64_t state[25]);
+
+private:
+    // lanes, with the lanes of ComplementMask stored inverted
+    uint64_t state[25];
+
+    // bytes absorbed or squeezed per permutation
+    size_t rate;
+
+    // domain separation and padding start
+    uint8_t suffix;
+
+    // byte position inside the rate
+    size_t position;
+
+    // set once padding was applied
+    bool squeezing;
+
+    // pad and switch to squeezing
+    void pad();
+};
+
+#endif // KECCAK_H
@@ -5,21 +5,66 @@
 #include <vector>
 #include <cstdint>
 
+class HashStateWriter;
+class HashStateReader;
+
 // define MD5
 class MD5 {
 public:
+    // digest size in bytes
+    static constexpr size_t OutputSize = 16;
+
+    // initialize object
+    MD5();
+
+    // update hash
+    void update(const std::string& data);
+
+    // update hash with raw bytes
+    void update(const uint8_t* data, size_t length);
+
+    // finalize and return hash
+    std::string final();
+
+    // finalize and write binary hash into digest
+    void final(uint8_t digest[OutputSize]);
+
+    // reset state and buffer
+    void reset();
+
     // compute hash based on input
     static std::string hash(const std::string& input);
 
+    // compute binary hash into digest
+    static void hash(const uint8_t* data, size_t length, uint8_t digest[OutputSize]);
+
+    // write streaming state for HashContext::serialize
+    void saveState(HashStateWriter& writer) const;
+
+    // restore streaming state written by saveState
+    void loadState(HashStateReader& reader);
+
 private:
-    // function to pad the input
-    static std::vector<uint8_t> paddata(const std::string& data);
+    // define block size
+    static constexpr size_t BlockSize = 64;
+
+    // define algorithm state A, B, C, D
+    uint32_t state[4];
+
+    // number of bits processed
+    uint64_t bitCount;
+
+    // buffer data before processing
+    uint8_t buffer[BlockSize];
+
+    // current position in the buffer
+    size_t bufferIndex;
+
+    // function to pad the buffer and process the last block
+    void padBuffer();
 
     // function to process 512-bit block 
     static void processBlock(uint32_t& A, uint32_t& B, uint32_t& C, uint32_t& D, const uint8_t* block);
-
-    // function to perform a left bitwise rotation
-    static uint32_t leftRotate(uint32_t x, uint32_t n);
 };
 
 #endif // MD5_H
@@ -0,0 +1,79 @@
+#ifndef MERKLETREE_H
+#define MERKLETREE_H
+
+#include "HashLite.h"
+#include "HashContext.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+class ThreadPool;
+
+// define inclusion proof of one leaf
+struct MerkleProof {
+    size_t index = 0;                         // leaf index
+    size_t leafCount = 0;                     // leaves in the tree the proof was taken from
+    std::vector<std::vector<uint8_t>> path;   // sibling hashes from the leaf level up
+};
+
+// define RFC 6962 style hash tree, leaves are HASH(0x00 || chunk) and nodes HASH(0x01 || left || right)
+// an unpaired last node moves up a level unchanged, which gives the RFC 6962 root for any leaf count
+class MerkleTree {
+public:
+    // initialize empty tree, algorithm must be SHA-1 or SHA-2
+    explicit MerkleTree(HashAlgorithm algorithm, size_t leafSize = 1 << 20);
+
+    // split data into leafSize chunks and build tree on the shared pool
+    void build(const uint8_t* data, size_t length);
+
+    // build tree on the given pool
+    void build(const uint8_t* data, size_t length, ThreadPool& pool);
+
+    // build tree over a file, reading a few leaves per worker at a time
+    void buildFile(const std::string& path);
+
+    // build tree over a file on the given pool
+    void buildFile(const std::string& path, ThreadPool& pool);
+
+    // replace the chunk of one leaf and rehash only its path to the root
+    // every leaf but the last takes exactly leafSize bytes, the last 1 to leafSize, throws runtime_error otherwise
+    void updateLeaf(size_t index, const uint8_t* data, size_t length);
+
+    // root hash, the hash of no data for an empty tree
+    std::vector<uint8_t> root() const;
+
+    // number of leaves
+    size_t leafCount() const;
+
+    // chunk size
+    size_t leafSize() const;
+
+    // inclusion proof of one leaf
+    MerkleProof proof(size_t index) const;
+
+    // check that chunk is leaf proof.index of the tree with the given root, without the rest of the data
+    static bool verify(HashAlgorithm algorithm, const uint8_t* chunk, size_t length,
+                       const MerkleProof& proof, const uint8_t* root);
+
+private:
+    // selected algorithm
+    HashAlgorithm algorithm;
+
+    // bytes per leaf
+    size_t chunkSize;
+
+    // digest size
+    size_t size;
+
+    // contexts with the leaf and node prefix already fed
+    HashContext leafPrefix;
+    HashContext nodePrefix;
+
+    // digests of each level, leaves first, root level last
+    std::vector<std::vector<uint8_t>> levels;
+
+    // hash interior levels from the leaf level
+    void buildLevels(ThreadPool& pool);
+};
+
+#endif // MERKLETREE_H
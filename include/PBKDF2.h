@@ -0,0 +1,39 @@
+#ifndef PBKDF2_H
+#define PBKDF2_H
+
+#include "HashLite.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+class ThreadPool;
+
+// define password based key derivation (RFC 8018) over HMAC
+class PBKDF2 {
+public:
+    // derive outputLength bytes, output blocks are computed in parallel on the shared pool
+    static void derive(HashAlgorithm algorithm, const uint8_t* password, size_t passwordLength,
+                       const uint8_t* salt, size_t saltLength, uint32_t iterations,
+                       uint8_t* output, size_t outputLength);
+
+    // derive key from strings
+    static std::vector<uint8_t> derive(HashAlgorithm algorithm, const std::string& password,
+                                       const std::string& salt, uint32_t iterations, size_t outputLength);
+
+    // derive one key per password with a shared salt, key i is written at outputs + i * outputLength
+    static void deriveBatch(HashAlgorithm algorithm, const HashInput* passwords, size_t count,
+                            const uint8_t* salt, size_t saltLength, uint32_t iterations,
+                            uint8_t* outputs, size_t outputLength);
+
+    // derive keys on the given pool
+    static void deriveBatch(HashAlgorithm algorithm, const HashInput* passwords, size_t count,
+                            const uint8_t* salt, size_t saltLength, uint32_t iterations,
+                            uint8_t* outputs, size_t outputLength, ThreadPool& pool);
+
+    // derive key on the calling thread only
+    static void deriveSerial(HashAlgorithm algorithm, const uint8_t* password, size_t passwordLength,
+                             const uint8_t* salt, size_t saltLength, uint32_t iterations,
+                             uint8_t* output, size_t outputLength);
+};
+
+#endif // PBKDF2_H
@@ -0,0 +1,117 @@
+#ifndef ROLLINGHASH_H
+#define ROLLINGHASH_H
+
+#include <cstddef>
+#include <cstdint>
+
+// define Rabin-Karp rolling hash, the window bytes as a polynomial in an odd base modulo 2^64
+// the window is implicit: bytes are added at the end and removed from the front, the caller keeps the bytes
+class RabinKarp {
+public:
+    // default base
+    static constexpr uint64_t DefaultBase = 0x100000001B3ULL;
+
+    // initialize empty window, throws runtime_error for an even base
+    explicit RabinKarp(uint64_t base = DefaultBase);
+
+    // append byte to the window
+    void add(uint8_t in);
+
+    // append bytes to the window
+    void add(const uint8_t* data, size_t length);
+
+    // drop the oldest byte of the window, which the caller passes back in
+    void remove(uint8_t out);
+
+    // slide a fixed size window by one byte
+    void roll(uint8_t out, uint8_t in);
+
+    // slide a fixed size window by steps bytes one at a time, values receives the hash after each step
+    // window points at its current first byte and size() + steps bytes must be readable
+    void roll(const uint8_t* window, size_t steps, uint64_t* values);
+
+    // slide a fixed size window by steps bytes, window points at its current first byte and size() + steps bytes
+    // must be readable, a window is rehashed from scratch once steps reaches size()
+    void advance(const uint8_t* window, size_t steps);
+
+    // hash of the window
+    uint64_t value() const;
+
+    // window bytes
+    size_t size() const;
+
+    // empty the window, the base is kept
+    void reset();
+
+    // compute hash of a whole window
+    static uint64_t hashValue(const uint8_t* data, size_t length, uint64_t base = DefaultBase);
+
+private:
+    // polynomial base
+    uint64_t base;
+
+    // multiplicative inverse of base modulo 2^64
+    uint64_t inverse;
+
+    // base to the power of the window size
+    uint64_t power;
+
+    // hash of the window
+    uint64_t hash;
+
+    // window bytes
+    size_t count;
+};
+
+// define Buzhash cyclic polynomial rolling hash, a rotate and xor per byte over a fixed random table
+// the window is implicit: bytes are added at the end and removed from the front, the caller keeps the bytes
+class Buzhash {
+public:
+    // initialize empty window
+    Buzhash();
+
+    // append byte to the window
+    void add(uint8_t in);
+
+    // append bytes to the window
+    void add(const uint8_t* data, size_t length);
+
+    // drop the oldest byte of the window, which the caller passes back in
+    void remove(uint8_t out);
+
+    // slide a fixed size window by one byte
+    void roll(uint8_t out, uint8_t in);
+
+    // slide a fixed size window by steps bytes one at a time, values receives the hash after each step
+    // window points at its current first byte and size() + steps bytes must be readable
+    void roll(const uint8_t* window, size_t steps, uint64_t* values);
+
+    // slide a fixed size window by steps bytes, window points at its current first byte and size() + steps bytes
+    // must be readable, a window is rehashed from scratch once steps reaches size()
+    void advance(const uint8_t* window, size_t steps);
+
+    // hash of the window
+    uint64_t value() const;
+
+    // window bytes
+    size_t size() const;
+
+    // empty the window
+    void reset();
+
+    // compute hash of a whole window
+    static uint64_t hashValue(const uint8_t* data, size_t length);
+
+    // hashes of every window of a size in data, out receives length - window + 1 values and nothing when data is
+    // shorter than a window, throws runtime_error for window 0
+    static void hashWindows(const uint8_t* data, size_t length, size_t window, uint64_t* out);
+
+private:
+    // hash of the window
+    uint64_t hash;
+
+    // window bytes
+    size_t count;
+};
+
+#endif // ROLLINGHASH_H
@@ -4,21 +4,42 @@
 #include <string>
 #include <cstdint>
 
+class HashStateWriter;
+class HashStateReader;
+
 // define sha1 class
 class SHA1 {
 public:
+    // digest size in bytes
+    static constexpr size_t OutputSize = 20;
+
     // initialize object
     SHA1();
 
     // update hash
     void update(const std::string& data);
 
+    // update hash with raw bytes
+    void update(const uint8_t* data, size_t length);
+
     // finalize and return hash
     std::string final();
 
+    // finalize and write binary hash into digest
+    void final(uint8_t digest[OutputSize]);
+
+    // Reset state and buffer
+    void reset();
+
     // compute hash
     static std::string hash(const std::string& input);
 
+    // write streaming state for HashContext::serialize
+    void saveState(HashStateWriter& writer) const;
+
+    // restore streaming state written by saveState
+    void loadState(HashStateReader& reader);
+
 private:
     // define block size
     static constexpr size_t BlockSize = 64;
@@ -35,17 +56,11 @@ private:
     // current position in the buffer
     size_t bufferIndex;
 
-    // Reset state and buffer
-    void reset();
-
     // Pad buffer to multiple of block
     void padBuffer();
 
     // Process block
-    void processBlock();
-
-    // Left rotate function
-    static uint32_t leftRotate(uint32_t value, size_t count);
+    void processBlock(const uint8_t* block);
 };
 
 #endif // SHA1_H
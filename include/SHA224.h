@@ -4,28 +4,46 @@
 #include <string>
 #include <cstdint>
 
+class HashStateWriter;
+class HashStateReader;
+
 // define class
 class SHA224 {
 public:
+    // define output size
+    static constexpr size_t OutputSize = 28;
+
     // initialize object
     SHA224();
 
     // update hash
     void update(const std::string& data);
 
+    // update hash with raw bytes
+    void update(const uint8_t* data, size_t length);
+
     // finalize hash
     std::string final();
 
+    // finalize hash and write binary digest
+    void final(uint8_t digest[OutputSize]);
+
+    // Reset state and buffer
+    void reset();
+
     // compute hash
     static std::string hash(const std::string& input);
 
+    // write streaming state for HashContext::serialize
+    void saveState(HashStateWriter& writer) const;
+
+    // restore streaming state written by saveState
+    void loadState(HashStateReader& reader);
+
 private:
     // define block size
     static constexpr size_t BlockSize = 64;
 
-    // define output size
-    static constexpr size_t OutputSize = 28;
-
     // define algorithm state 
     uint32_t state[8];
 
@@ -38,9 +56,6 @@ private:
     // current position in buffer
     size_t bufferIndex;
 
-    // Reset state and buffer
-    void reset();
-
     // Pad the buffer to multiple of block
     void padBuffer();
 
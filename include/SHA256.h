@@ -5,13 +5,73 @@
 #include <string>
 #include <cstdint>
 
+class HashStateWriter;
+class HashStateReader;
+
 // define class
 class SHA256 {
 public:
+    // digest size in bytes
+    static constexpr size_t OutputSize = 32;
+
+    // initialize object
+    SHA256();
+
+    // update hash
+    void update(const std::string& data);
+
+    // update hash with raw bytes
+    void update(const uint8_t* data, size_t length);
+
+    // finalize and return hash
+    std::string final();
+
+    // finalize and write binary hash into digest
+    void final(uint8_t digest[OutputSize]);
+
+    // Reset state and buffer
+    void reset();
+
     // compute hash
     static std::string hash(const std::string& data);
 
+    // compute binary hash into digest
+    static void hash(const uint8_t* data, size_t length, uint8_t digest[OutputSize]);
+
+    // hash exactly 32 bytes, such as another digest
+    static void hash32(const uint8_t data[32], uint8_t digest[OutputSize]);
+
+    // hash exactly 64 bytes, such as two concatenated digests
+    static void hash64(const uint8_t data[64], uint8_t digest[OutputSize]);
+
+    // compute double SHA-256, SHA256(SHA256(data))
+    static void hash256d(const uint8_t* data, size_t length, uint8_t digest[OutputSize]);
+
+    // write streaming state for HashContext::serialize
+    void saveState(HashStateWriter& writer) const;
+
+    // restore streaming state written by saveState
+    void loadState(HashStateReader& reader);
+
 private:
+    // define block size
+    static constexpr size_t BlockSize = 64;
+
+    // define algorithm state
+    uint32_t state[8];
+
+    // number of bits processed
+    uint64_t bitCount;
+
+    // Buffer data before processing
+    uint8_t buffer[BlockSize];
+
+    // current position in the buffer
+    size_t bufferIndex;
+
+    // Pad buffer and process final block
+    void padBuffer();
+
     // Rotate right function
     static uint32_t rotateRight(uint32_t x, uint32_t n);
 
@@ -33,11 +93,14 @@ private:
     // SmallSigma1 function
     static uint32_t smallSigma1(uint32_t x);
 
-    // Pad data
-    static std::vector<uint8_t> paddata(const std::string& data);
-
     // Process block
-    static void processBlock(const std::vector<uint8_t>& block, uint32_t hashValues[8]);
+    static void processBlock(const uint8_t* block, uint32_t hashValues[8]);
+
+    // extend the first 16 schedule words into all 64
+    static void expandSchedule(uint32_t W[64]);
+
+    // run the 64 rounds over an expanded schedule
+    static void compress(const uint32_t W[64], uint32_t hashValues[8]);
 
     // define constant array K
     static const uint32_t K[64];
@@ -0,0 +1,58 @@
+#ifndef SHA3_H
+#define SHA3_H
+
+#include "Keccak.h"
+#include <string>
+#include <cstdint>
+
+// define SHA-3 class, the digest size picks SHA3-224, SHA3-256, SHA3-384 or SHA3-512
+class SHA3 {
+public:
+    // digest sizes in bytes
+    static constexpr size_t OutputSize224 = 28;
+    static constexpr size_t OutputSize256 = 32;
+    static constexpr size_t OutputSize384 = 48;
+    static constexpr size_t OutputSize512 = 64;
+
+    // initialize object, outputSize is one of the digest sizes above
+    explicit SHA3(size_t outputSize = OutputSize256);
+
+    // update hash
+    void update(const std::string& data);
+
+    // update hash with raw bytes
+    void update(const uint8_t* data, size_t length);
+
+    // finalize and return hash
+    std::string final();
+
+    // finalize and write outputSize() bytes of binary hash into digest
+    void final(uint8_t* digest);
+
+    // reset state, the digest size is kept
+    void reset();
+
+    // digest size in bytes
+    size_t outputSize() const;
+
+    // compute hash
+    static std::string hash(const std::string& data, size_t outputSize = OutputSize256);
+
+    // compute binary hash into digest
+    static void hash(const uint8_t* data, size_t length, uint8_t* digest, size_t outputSize = OutputSize256);
+
+    // write streaming state for HashContext::serialize
+    void saveState(HashStateWriter& writer) const;
+
+    // restore streaming state written by saveState
+    void loadState(HashStateReader& reader);
+
+private:
+    // digest size in bytes
+    size_t size;
+
+    // sponge with capacity of twice the digest size
+    Keccak sponge;
+};
+
+#endif // SHA3_H
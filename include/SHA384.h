@@ -1,22 +1,40 @@
 #ifndef SHA384_H
 #define SHA384_H
 
+#include "SHA512.h"
 #include <string>
-#include <vector>
 #include <cstdint>
 
-// define class
-class SHA384 {
+// define SHA-384 class, the SHA-512 core with its own initial hash values and a truncated digest
+class SHA384 : private SHA512 {
 public:
+    // digest size in bytes
+    static constexpr size_t OutputSize = 48;
+
+    // initialize object
+    SHA384();
+
+    // update hash
+    using SHA512::update;
+
+    // reset state and buffer
+    using SHA512::reset;
+
+    // streaming state for HashContext::serialize
+    using SHA512::saveState;
+    using SHA512::loadState;
+
+    // finalize and return hash
+    std::string final();
+
+    // finalize and write binary hash into digest
+    void final(uint8_t digest[OutputSize]);
+
     // compute hash
     static std::string hash(const std::string& input);
 
-private:
-    // pad data
-    static std::vector<uint8_t> paddata(const std::vector<uint8_t>& data);
-
-    // process block
-    static void processBlock(const uint8_t* block, uint64_t* H);
+    // compute binary hash into digest
+    static void hash(const uint8_t* data, size_t length, uint8_t digest[OutputSize]);
 };
 
 #endif // SHA384_H
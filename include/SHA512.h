@@ -5,13 +5,77 @@
 #include <vector>
 #include <cstdint>
 
+class HashStateWriter;
+class HashStateReader;
+
 // define class
 class SHA512 {
 public:
+    // digest size in bytes
+    static constexpr size_t OutputSize = 64;
+
+    // initialize object
+    SHA512();
+
+    // update hash
+    void update(const std::string& data);
+
+    // update hash with raw bytes
+    void update(const uint8_t* data, size_t length);
+
+    // finalize and return hash
+    std::string final();
+
+    // finalize and write binary hash into digest
+    void final(uint8_t digest[OutputSize]);
+
+    // reset state and buffer
+    void reset();
+
     // compute hash
     static std::string hash(const std::string &data);
 
+    // compute binary hash into digest
+    static void hash(const uint8_t* data, size_t length, uint8_t digest[OutputSize]);
+
+    // write streaming state for HashContext::serialize
+    void saveState(HashStateWriter& writer) const;
+
+    // restore streaming state written by saveState
+    void loadState(HashStateReader& reader);
+
+protected:
+    // initialize object with other initial hash values, used by the truncated SHA-512/t variants
+    explicit SHA512(const uint64_t initial[8]);
+
+    // pad, write the first length bytes of the big-endian hash and reset
+    void finish(uint8_t* digest, size_t length);
+
 private:
+    // define block size
+    static constexpr size_t BlockSize = 128;
+
+    // initial hash values restored by reset
+    const uint64_t* initial;
+
+    // define algorithm state
+    uint64_t state[8];
+
+    // number of bits processed
+    uint64_t bitCount;
+
+    // buffer data before processing
+    uint8_t buffer[BlockSize];
+
+    // current position in the buffer
+    size_t bufferIndex;
+
+    // pad buffer and process the last block
+    void padBuffer();
+
+    // process block
+    static void processBlock(const uint8_t* block, uint64_t* H);
+
     // define constants K and H0
     static const uint64_t K[80];   // round constants
     static const uint64_t H0[8];   // Initial hash
@@ -39,9 +103,6 @@ private:
 
     // Small sigma1 function
     static uint64_t sigma1(uint64_t x);
-
-    // pad data
-    static std::vector<uint8_t> paddata(const std::string &data);
 };
 
 #endif // SHA512_H
@@ -0,0 +1,40 @@
+#ifndef SHA512_256_H
+#define SHA512_256_H
+
+#include "SHA512.h"
+#include <string>
+#include <cstdint>
+
+// define SHA-512/256 class, the SHA-512 core with its own initial hash values and a truncated digest
+class SHA512_256 : private SHA512 {
+public:
+    // digest size in bytes
+    static constexpr size_t OutputSize = 32;
+
+    // initialize object
+    SHA512_256();
+
+    // update hash
+    using SHA512::update;
+
+    // reset state and buffer
+    using SHA512::reset;
+
+    // streaming state for HashContext::serialize
+    using SHA512::saveState;
+    using SHA512::loadState;
+
+    // finalize and return hash
+    std::string final();
+
+    // finalize and write binary hash into digest
+    void final(uint8_t digest[OutputSize]);
+
+    // compute hash
+    static std::string hash(const std::string& data);
+
+    // compute binary hash into digest
+    static void hash(const uint8_t* data, size_t length, uint8_t digest[OutputSize]);
+};
+
+#endif // SHA512_256_H
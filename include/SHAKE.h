@@ -0,0 +1,60 @@
+#ifndef SHAKE_H
+#define SHAKE_H
+
+#include "Keccak.h"
+#include <string>
+#include <cstdint>
+
+// define SHAKE class, an extendable output function at 128 or 256 bit security
+class SHAKE {
+public:
+    // default output sizes in bytes used by final
+    static constexpr size_t OutputSize128 = 32;
+    static constexpr size_t OutputSize256 = 64;
+
+    // initialize object, securityBits is 128 or 256
+    explicit SHAKE(size_t securityBits = 256);
+
+    // update hash, throws once output was squeezed
+    void update(const std::string& data);
+
+    // update hash with raw bytes, throws once output was squeezed
+    void update(const uint8_t* data, size_t length);
+
+    // write the next length bytes of output, can be called repeatedly to stream output
+    void squeeze(uint8_t* output, size_t length);
+
+    // finalize and return default size output
+    std::string final();
+
+    // finalize and write outputSize() bytes into digest
+    void final(uint8_t* digest);
+
+    // reset state, the security level is kept
+    void reset();
+
+    // default output size in bytes, twice the security level
+    size_t outputSize() const;
+
+    // compute length bytes of output
+    static void hash(const uint8_t* data, size_t length, uint8_t* output, size_t outputLength,
+                     size_t securityBits = 256);
+
+    // compute default size output as hex
+    static std::string hash(const std::string& data, size_t securityBits = 256);
+
+    // write streaming state for HashContext::serialize
+    void saveState(HashStateWriter& writer) const;
+
+    // restore streaming state written by saveState
+    void loadState(HashStateReader& reader);
+
+private:
+    // security level in bits
+    size_t security;
+
+    // sponge with capacity of twice the security level
+    Keccak sponge;
+};
+
+#endif // SHAKE_H
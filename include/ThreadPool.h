@@ -0,0 +1,87 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// define thread pool options
+struct ThreadPoolOptions {
+    // number of worker threads, 0 uses all hardware threads
+    size_t threads = 0;
+
+    // cpu ids to pin workers to, worker i runs on affinity[i % size], empty for no pinning
+    std::vector<int> affinity;
+};
+
+// define work-stealing thread pool
+class ThreadPool {
+public:
+    // task type run by workers
+    using Task = std::function<void()>;
+
+    // initialize pool and start workers
+    explicit ThreadPool(const ThreadPoolOptions& options = ThreadPoolOptions());
+
+    // stop workers after draining queued tasks
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // queue task, workers steal from each other when idle
+    void submit(Task task);
+
+    // split [0, count) into ranges and run body on each, returns when all ranges are done
+    void parallelFor(size_t count, const std::function<void(size_t begin, size_t end)>& body);
+
+    // number of worker threads
+    size_t size() const;
+
+    // process wide pool sized to the hardware
+    static ThreadPool& shared();
+
+private:
+    // per worker queue, owner pops from the back and thieves from the front
+    struct Worker {
+        std::deque<Task> tasks;
+        std::mutex mutex;
+        std::thread thread;
+    };
+
+    // worker queues
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    // sleeping workers wait here
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+
+    // number of queued tasks
+    std::atomic<size_t> pending;
+
+    // set on shutdown
+    std::atomic<bool> stopping;
+
+    // round robin queue for submissions from outside the pool
+    std::atomic<size_t> nextQueue;
+
+    // take a task, own queue first then steal from the others
+    bool popTask(size_t index, Task& task);
+
+    // run one queued task on the calling thread if any
+    bool runPendingTask();
+
+    // worker main loop
+    void workerLoop(size_t index);
+
+    // pin thread to cpu
+    static void pinThread(std::thread& thread, int cpu);
+};
+
+#endif // THREADPOOL_H
@@ -0,0 +1,46 @@
+#ifndef XXH128_H
+#define XXH128_H
+
+#include "XXH3.h"
+#include <string>
+#include <cstdint>
+
+// define XXH128 class, the 128-bit output of XXH3
+class XXH128 : private XXH3 {
+public:
+    // digest size in bytes
+    static constexpr size_t OutputSize = 16;
+
+    // initialize object with seed
+    explicit XXH128(uint64_t seed = 0);
+
+    // update hash
+    using XXH3::update;
+
+    // reset state and buffer, the seed is kept
+    using XXH3::reset;
+
+    // streaming state for HashContext::serialize
+    using XXH3::saveState;
+    using XXH3::loadState;
+
+    // finalize and return hash as hex
+    std::string final();
+
+    // finalize and write hash as big-endian bytes, high half first
+    void final(uint8_t digest[OutputSize]);
+
+    // finalize and return hash value
+    XXH128Value finalValue();
+
+    // compute hash as hex
+    static std::string hash(const std::string& data);
+
+    // compute hash as big-endian bytes
+    static void hash(const uint8_t* data, size_t length, uint8_t digest[OutputSize]);
+
+    // compute hash value
+    static XXH128Value hashValue(const uint8_t* data, size_t length, uint64_t seed = 0);
+};
+
+#endif // XXH128_H
@@ -0,0 +1,108 @@
+#ifndef XXH3_H
+#define XXH3_H
+
+#include <string>
+#include <cstdint>
+
+class HashStateWriter;
+class HashStateReader;
+
+// define 128-bit hash value
+struct XXH128Value {
+    uint64_t low;  // low 64 bits
+    uint64_t high; // high 64 bits
+};
+
+// define XXH3 class, a fast non-cryptographic hash with 64-bit output
+class XXH3 {
+public:
+    // digest size in bytes
+    static constexpr size_t OutputSize = 8;
+
+    // initialize object with seed
+    explicit XXH3(uint64_t seed = 0);
+
+    // update hash
+    void update(const std::string& data);
+
+    // update hash with raw bytes
+    void update(const uint8_t* data, size_t length);
+
+    // finalize and return hash as hex
+    std::string final();
+
+    // finalize and write hash as big-endian bytes
+    void final(uint8_t digest[OutputSize]);
+
+    // finalize and return hash value
+    uint64_t finalValue();
+
+    // reset state and buffer, the seed is kept
+    void reset();
+
+    // compute hash as hex
+    static std::string hash(const std::string& data);
+
+    // compute hash as big-endian bytes
+    static void hash(const uint8_t* data, size_t length, uint8_t digest[OutputSize]);
+
+    // compute hash value
+    static uint64_t hashValue(const uint8_t* data, size_t length, uint64_t seed = 0);
+
+    // write streaming state for HashContext::serialize
+    void saveState(HashStateWriter& writer) const;
+
+    // restore streaming state written by saveState
+    void loadState(HashStateReader& reader);
+
+protected:
+    // hash of everything fed so far, 128-bit output
+    XXH128Value value128() const;
+
+    // one shot hash, 128-bit output
+    static XXH128Value oneShot128(const uint8_t* data, size_t length, uint64_t seed);
+
+private:
+    // define secret, stripe and buffer size
+    static constexpr size_t SecretSize = 192;
+    static constexpr size_t StripeSize = 64;
+    static constexpr size_t BufferSize = 256;
+
+    // inputs up to this size are hashed in one shot from the buffer
+    static constexpr size_t MidSizeMax = 240;
+
+    // stripes between scrambles
+    static constexpr size_t StripesPerBlock = (SecretSize - StripeSize) / 8;
+
+    // seed of the hash
+    uint64_t seed;
+
+    // secret derived from the seed
+    uint8_t secret[SecretSize];
+
+    // stripe accumulators
+    uint64_t acc[8];
+
+    // stripes consumed since the last scramble
+    size_t stripesSoFar;
+
+    // total bytes fed
+    uint64_t totalLength;
+
+    // buffer data before processing, keeps the last stripe consumed for the final block
+    uint8_t buffer[BufferSize];
+
+    // current position in the buffer
+    size_t bufferIndex;
+
+    // accumulators after the buffered tail, for inputs over MidSizeMax
+    void finalAccumulators(uint64_t out[8]) const;
+
+    // hash of everything fed so far, 64-bit output
+    uint64_t value64() const;
+
+    // one shot hash, 64-bit output
+    static uint64_t oneShot64(const uint8_t* data, size_t length, uint64_t seed);
+};
+
+#endif // XXH3_H
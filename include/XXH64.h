@@ -0,0 +1,75 @@
+#ifndef XXH64_H
+#define XXH64_H
+
+#include <string>
+#include <cstdint>
+
+class HashStateWriter;
+class HashStateReader;
+
+// define XXH64 class, a fast non-cryptographic hash
+class XXH64 {
+public:
+    // digest size in bytes
+    static constexpr size_t OutputSize = 8;
+
+    // initialize object with seed
+    explicit XXH64(uint64_t seed = 0);
+
+    // update hash
+    void update(const std::string& data);
+
+    // update hash with raw bytes
+    void update(const uint8_t* data, size_t length);
+
+    // finalize and return hash as hex
+    std::string final();
+
+    // finalize and write hash as big-endian bytes
+    void final(uint8_t digest[OutputSize]);
+
+    // finalize and return hash value
+    uint64_t finalValue();
+
+    // reset state and buffer, the seed is kept
+    void reset();
+
+    // compute hash as hex
+    static std::string hash(const std::string& data);
+
+    // compute hash as big-endian bytes
+    static void hash(const uint8_t* data, size_t length, uint8_t digest[OutputSize]);
+
+    // compute hash value
+    static uint64_t hashValue(const uint8_t* data, size_t length, uint64_t seed = 0);
+
+    // write streaming state for HashContext::serialize
+    void saveState(HashStateWriter& writer) const;
+
+    // restore streaming state written by saveState
+    void loadState(HashStateReader& reader);
+
+private:
+    // define stripe size
+    static constexpr size_t StripeSize = 32;
+
+    // seed of the hash
+    uint64_t seed;
+
+    // stripe accumulators
+    uint64_t acc[4];
+
+    // total bytes fed
+    uint64_t totalLength;
+
+    // buffer data before processing
+    uint8_t buffer[StripeSize];
+
+    // current position in the buffer
+    size_t bufferIndex;
+
+    // hash value of the remaining tail
+    static uint64_t finish(uint64_t h, const uint8_t* tail, size_t length);
+};
+
+#endif // XXH64_H
@@ -0,0 +1,651 @@
+#include "BLAKE3.h"
+#include "HashState.h"
+#include "ThreadPool.h"
+#include <sstream>
+#include <iomanip>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept> // Error handling
+#include <vector>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define BLAKE3_AVX2 1
+#endif
+
+// domain flags
+static constexpr uint32_t ChunkStart = 1 << 0;
+static constexpr uint32_t ChunkEnd = 1 << 1;
+static constexpr uint32_t Parent = 1 << 2;
+static constexpr uint32_t Root = 1 << 3;
+static constexpr uint32_t KeyedHash = 1 << 4;
+static constexpr uint32_t DeriveKeyContext = 1 << 5;
+static constexpr uint32_t DeriveKeyMaterial = 1 << 6;
+
+// initial chaining value, same as SHA-256
+static constexpr uint32_t IV[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+// message word order of each round
+static constexpr uint8_t MessageSchedule[7][16] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8},
+    {3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1},
+    {10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6},
+    {12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4},
+    {9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7},
+    {11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13},
+};
+
+// subtrees of at least this many chunks are hashed on the thread pool
+static constexpr size_t ParallelChunks = 128;
+
+// largest subtree hashed in one step, bounds the chaining value scratch space
+static constexpr size_t MaxSubtreeChunks = 1 << 16;
+
+// chunks compressed together by the wide kernel
+static constexpr size_t ChunkLanes = 8;
+
+// rotate bits right n times
+static inline uint32_t rotr(uint32_t x, uint32_t n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+// mix two message words into one column or diagonal
+static inline void mix(uint32_t v[16], size_t a, size_t b, size_t c, size_t d, uint32_t x, uint32_t y) {
+    v[a] = v[a] + v[b] + x;
+    v[d] = rotr(v[d] ^ v[a], 16);
+    v[c] = v[c] + v[d];
+    v[b] = rotr(v[b] ^ v[c], 12);
+    v[a] = v[a] + v[b] + y;
+    v[d] = rotr(v[d] ^ v[a], 8);
+    v[c] = v[c] + v[d];
+    v[b] = rotr(v[b] ^ v[c], 7);
+}
+
+// one round, columns then diagonals
+static inline void fullRound(uint32_t v[16], const uint32_t m[16], const uint8_t s[16]) {
+    mix(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+    mix(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+    mix(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+    mix(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+    mix(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+    mix(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+    mix(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+    mix(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+}
+
+// compress block, writes the full 16 word output
+static void compress(const uint32_t cv[8], const uint32_t block[16], uint64_t counter,
+                     uint32_t blockLength, uint32_t flags, uint32_t out[16]) {
+    uint32_t v[16] = {
+        cv[0], cv[1], cv[2], cv[3], cv[4], cv[5], cv[6], cv[7],
+        IV[0], IV[1], IV[2], IV[3],
+        static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32), blockLength, flags
+    };
+    for (size_t r = 0; r < 7; ++r) {
+        fullRound(v, block, MessageSchedule[r]);
+    }
+    for (size_t i = 0; i < 8; ++i) {
+        out[i] = v[i] ^ v[i + 8];
+        out[i + 8] = v[i + 8] ^ cv[i];
+    }
+}
+
+// compress block in place, keeps only the chaining value
+static void compressInPlace(uint32_t cv[8], const uint32_t block[16], uint64_t counter,
+                            uint32_t blockLength, uint32_t flags) {
+    uint32_t out[16];
+    compress(cv, block, counter, blockLength, flags, out);
+    std::memcpy(cv, out, 8 * sizeof(uint32_t));
+}
+
+// load little-endian block words
+static void loadBlock(const uint8_t* bytes, uint32_t block[16]) {
+    for (size_t i = 0; i < 16; ++i) {
+        block[i] = static_cast<uint32_t>(bytes[i * 4]) | (static_cast<uint32_t>(bytes[i * 4 + 1]) << 8) |
+                   (static_cast<uint32_t>(bytes[i * 4 + 2]) << 16) | (static_cast<uint32_t>(bytes[i * 4 + 3]) << 24);
+    }
+}
+
+// load 32 key bytes as words
+static void loadKey(const uint8_t bytes[32], uint32_t words[8]) {
+    uint8_t padded[64] = {};
+    uint32_t block[16];
+    std::memcpy(padded, bytes, 32);
+    loadBlock(padded, block);
+    std::memcpy(words, block, 8 * sizeof(uint32_t));
+}
+
+// chaining value of a full chunk that is not the root
+static void chunkValue(const uint32_t key[8], uint32_t mode, const uint8_t* chunk, uint64_t counter, uint32_t cv[8]) {
+    std::memcpy(cv, key, 8 * sizeof(uint32_t));
+    uint32_t block[16];
+    for (size_t b = 0; b < 16; ++b) {
+        uint32_t flags = mode | (b == 0 ? ChunkStart : 0) | (b == 15 ? ChunkEnd : 0);
+        loadBlock(chunk + b * 64, block);
+        compressInPlace(cv, block, counter, 64, flags);
+    }
+}
+
+// chaining value of a parent that is not the root
+static void parentValue(const uint32_t key[8], uint32_t mode, const uint32_t left[8], const uint32_t right[8],
+                        uint32_t cv[8]) {
+    uint32_t block[16];
+    std::memcpy(block, left, 8 * sizeof(uint32_t));
+    std::memcpy(block + 8, right, 8 * sizeof(uint32_t));
+    std::memcpy(cv, key, 8 * sizeof(uint32_t));
+    compressInPlace(cv, block, 0, 64, mode | Parent);
+}
+
+#ifdef BLAKE3_AVX2
+// rotate eight lanes right by 16 bits
+__attribute__((target("avx2")))
+static inline __m256i rotr16Avx2(__m256i x) {
+    const __m256i order = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+                                           2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+    return _mm256_shuffle_epi8(x, order);
+}
+
+// rotate eight lanes right by 12 bits
+__attribute__((target("avx2")))
+static inline __m256i rotr12Avx2(__m256i x) {
+    return _mm256_or_si256(_mm256_srli_epi32(x, 12), _mm256_slli_epi32(x, 20));
+}
+
+// rotate eight lanes right by 8 bits
+__attribute__((target("avx2")))
+static inline __m256i rotr8Avx2(__m256i x) {
+    const __m256i order = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12,
+                                           1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+    return _mm256_shuffle_epi8(x, order);
+}
+
+// rotate eight lanes right by 7 bits
+__attribute__((target("avx2")))
+static inline __m256i rotr7Avx2(__m256i x) {
+    return _mm256_or_si256(_mm256_srli_epi32(x, 7), _mm256_slli_epi32(x, 25));
+}
+
+// mix two message words into one column or diagonal of eight states
+__attribute__((target("avx2")))
+static inline void mixAvx2(__m256i v[16], size_t a, size_t b, size_t c, size_t d, __m256i x, __m256i y) {
+    v[a] = _mm256_add_epi32(_mm256_add_epi32(v[a], v[b]), x);
+    v[d] = rotr16Avx2(_mm256_xor_si256(v[d], v[a]));
+    v[c] = _mm256_add_epi32(v[c], v[d]);
+    v[b] = rotr12Avx2(_mm256_xor_si256(v[b], v[c]));
+    v[a] = _mm256_add_epi32(_mm256_add_epi32(v[a], v[b]), y);
+    v[d] = rotr8Avx2(_mm256_xor_si256(v[d], v[a]));
+    v[c] = _mm256_add_epi32(v[c], v[d]);
+    v[b] = rotr7Avx2(_mm256_xor_si256(v[b], v[c]));
+}
+
+// one round of eight states, columns then diagonals
+__attribute__((target("avx2")))
+static inline void fullRoundAvx2(__m256i v[16], const __m256i m[16], const uint8_t s[16]) {
+    mixAvx2(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+    mixAvx2(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+    mixAvx2(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+    mixAvx2(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+    mixAvx2(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+    mixAvx2(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+    mixAvx2(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+    mixAvx2(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+}
+
+// transpose eight rows of eight words, row i becomes word i of every row
+__attribute__((target("avx2")))
+static inline void transposeAvx2(__m256i rows[8]) {
+    __m256i pairs[8];
+    for (size_t i = 0; i < 4; ++i) {
+        pairs[2 * i] = _mm256_unpacklo_epi32(rows[2 * i], rows[2 * i + 1]);
+        pairs[2 * i + 1] = _mm256_unpackhi_epi32(rows[2 * i], rows[2 * i + 1]);
+    }
+
+    __m256i quads[8];
+    for (size_t i = 0; i < 2; ++i) {
+        quads[4 * i] = _mm256_unpacklo_epi64(pairs[4 * i], pairs[4 * i + 2]);
+        quads[4 * i + 1] = _mm256_unpackhi_epi64(pairs[4 * i], pairs[4 * i + 2]);
+        quads[4 * i + 2] = _mm256_unpacklo_epi64(pairs[4 * i + 1], pairs[4 * i + 3]);
+        quads[4 * i + 3] = _mm256_unpackhi_epi64(pairs[4 * i + 1], pairs[4 * i + 3]);
+    }
+
+    for (size_t i = 0; i < 4; ++i) {
+        rows[i] = _mm256_permute2x128_si256(quads[i], quads[i + 4], 0x20);
+        rows[i + 4] = _mm256_permute2x128_si256(quads[i], quads[i + 4], 0x31);
+    }
+}
+
+// chaining values of eight consecutive full chunks that are not the root, one chunk per lane
+__attribute__((target("avx2")))
+static void chunkValuesAvx2(const uint32_t key[8], uint32_t mode, const uint8_t* data, uint64_t counter,
+                            uint32_t cvs[ChunkLanes * 8]) {
+    __m256i h[8];
+    for (size_t i = 0; i < 8; ++i) {
+        h[i] = _mm256_set1_epi32(static_cast<int>(key[i]));
+    }
+
+    uint32_t counterLow[ChunkLanes];
+    uint32_t counterHigh[ChunkLanes];
+    for (size_t lane = 0; lane < ChunkLanes; ++lane) {
+        counterLow[lane] = static_cast<uint32_t>(counter + lane);
+        counterHigh[lane] = static_cast<uint32_t>((counter + lane) >> 32);
+    }
+
+    for (size_t b = 0; b < 16; ++b) {
+        // message words are little-endian, load each lane's block and transpose to one word per register
+        __m256i m[16];
+        for (size_t half = 0; half < 2; ++half) {
+            __m256i rows[8];
+            for (size_t lane = 0; lane < ChunkLanes; ++lane) {
+                const uint8_t* words = data + lane * 16 * 64 + b * 64 + half * 32;
+                rows[lane] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words));
+            }
+            transposeAvx2(rows);
+            std::copy(rows, rows + 8, m + half * 8);
+        }
+
+        uint32_t flags = mode | (b == 0 ? ChunkStart : 0) | (b == 15 ? ChunkEnd : 0);
+        __m256i v[16] = {
+            h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7],
+            _mm256_set1_epi32(static_cast<int>(IV[0])), _mm256_set1_epi32(static_cast<int>(IV[1])),
+            _mm256_set1_epi32(static_cast<int>(IV[2])), _mm256_set1_epi32(static_cast<int>(IV[3])),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(counterLow)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(counterHigh)),
+            _mm256_set1_epi32(64), _mm256_set1_epi32(static_cast<int>(flags))
+        };
+        for (size_t r = 0; r < 7; ++r) {
+            fullRoundAvx2(v, m, MessageSchedule[r]);
+        }
+        for (size_t i = 0; i < 8; ++i) {
+            h[i] = _mm256_xor_si256(v[i], v[i + 8]);
+        }
+    }
+
+    // back to one chaining value per lane
+    transposeAvx2(h);
+    for (size_t lane = 0; lane < ChunkLanes; ++lane) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(cvs + lane * 8), h[lane]);
+    }
+}
+#endif
+
+// cpu support of the avx2 kernel
+static bool avx2Available() {
+#ifdef BLAKE3_AVX2
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+// chaining values of count consecutive full chunks that are not the root, with the widest kernel the cpu supports
+static void chunkValues(const uint32_t key[8], uint32_t mode, const uint8_t* data, size_t count, uint64_t counter,
+                        uint32_t* cvs) {
+    size_t i = 0;
+#ifdef BLAKE3_AVX2
+    if (avx2Available()) {
+        for (; i + ChunkLanes <= count; i += ChunkLanes) {
+            chunkValuesAvx2(key, mode, data + i * 16 * 64, counter + i, cvs + i * 8);
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        chunkValue(key, mode, data + i * 16 * 64, counter + i, cvs + i * 8);
+    }
+}
+
+// hash mode constructor
+BLAKE3::BLAKE3() : BLAKE3(IV, 0) {}
+
+// keyed hash constructor
+BLAKE3::BLAKE3(const uint8_t keyBytes[KeySize]) : mode(KeyedHash) {
+    loadKey(keyBytes, key);
+    reset();
+}
+
+// derive key constructor, the context is hashed into the key
+BLAKE3 BLAKE3::deriveKey(const std::string& context) {
+    BLAKE3 contextHasher(IV, DeriveKeyContext);
+    contextHasher.update(context);
+    uint8_t contextKey[KeySize];
+    contextHasher.final(contextKey);
+
+    uint32_t words[8];
+    loadKey(contextKey, words);
+    return BLAKE3(words, DeriveKeyMaterial);
+}
+
+// key words constructor
+BLAKE3::BLAKE3(const uint32_t keyWords[8], uint32_t mode) : mode(mode) {
+    std::memcpy(key, keyWords, sizeof(key));
+    reset();
+}
+
+// reset object state
+void BLAKE3::reset() {
+    startChunk(0);
+    cvStackLength = 0;
+}
+
+// start empty chunk
+void BLAKE3::startChunk(uint64_t counter) {
+    std::memcpy(chunkState, key, sizeof(chunkState));
+    chunkCounter = counter;
+    blocksCompressed = 0;
+    bufferIndex = 0;
+}
+
+// bytes in chunk
+size_t BLAKE3::chunkLength() const {
+    return blocksCompressed * BlockSize + bufferIndex;
+}
+
+// feed chunk bytes
+void BLAKE3::chunkUpdate(const uint8_t* data, size_t length) {
+    while (length > 0) {
+        // compress a full buffer only once more input shows it is not the last block
+        if (bufferIndex == BlockSize) {
+            uint32_t block[16];
+            loadBlock(buffer, block);
+            compressInPlace(chunkState, block, chunkCounter, BlockSize,
+                            mode | (blocksCompressed == 0 ? ChunkStart : 0));
+            ++blocksCompressed;
+            bufferIndex = 0;
+        }
+
+        size_t take = std::min(BlockSize - bufferIndex, length);
+        std::memcpy(buffer + bufferIndex, data, take);
+        bufferIndex += take;
+        data += take;
+        length -= take;
+    }
+}
+
+// merge subtrees
+void BLAKE3::mergeStack(uint64_t totalChunks) {
+    size_t complete = 0; // one completed subtree per set bit
+    for (uint64_t bits = totalChunks; bits != 0; bits &= bits - 1) {
+        ++complete;
+    }
+    while (cvStackLength > complete) {
+        parentValue(key, mode, cvStack[cvStackLength - 2], cvStack[cvStackLength - 1], cvStack[cvStackLength - 2]);
+        --cvStackLength;
+    }
+}
+
+// push subtree, merging lazily so the last subtree is never merged before the root is known
+void BLAKE3::pushStack(const uint32_t cv[8], uint64_t counter) {
+    mergeStack(counter);
+    std::memcpy(cvStack[cvStackLength++], cv, 8 * sizeof(uint32_t));
+}
+
+// hash subtree of whole chunks
+void BLAKE3::subtreeValues(const uint8_t* data, size_t chunks, uint64_t counter,
+                           uint32_t left[8], uint32_t right[8]) const {
+    std::vector<uint32_t> values(chunks * 8);
+    std::vector<uint32_t> parents(chunks / 2 * 8);
+
+    // chunks are independent
+    auto hashChunks = [&](size_t begin, size_t end) {
+        chunkValues(key, mode, data + begin * ChunkSize, end - begin, counter + begin, values.data() + begin * 8);
+    };
+    if (chunks >= ParallelChunks) {
+        // ranges hold whole groups of lanes so every chunk goes through the wide kernel
+        ThreadPool::shared().parallelFor(chunks / ChunkLanes, [&](size_t begin, size_t end) {
+            hashChunks(begin * ChunkLanes, end * ChunkLanes);
+        });
+    } else {
+        hashChunks(0, chunks);
+    }
+
+    // reduce level by level until the two children of the subtree root remain
+    for (size_t count = chunks; count > 2; count /= 2) {
+        auto hashParents = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                parentValue(key, mode, values.data() + 2 * i * 8, values.data() + (2 * i + 1) * 8,
+                            parents.data() + i * 8);
+            }
+        };
+        if (count / 2 >= ParallelChunks) {
+            ThreadPool::shared().parallelFor(count / 2, hashParents);
+        } else {
+            hashParents(0, count / 2);
+        }
+        values.swap(parents);
+    }
+
+    std::memcpy(left, values.data(), 8 * sizeof(uint32_t));
+    std::memcpy(right, values.data() + 8, 8 * sizeof(uint32_t));
+}
+
+// update state
+void BLAKE3::update(const std::string& data) {
+    update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+}
+
+// update state with raw bytes
+void BLAKE3::update(const uint8_t* data, size_t length) {
+    // complete a partially filled chunk first
+    if (chunkLength() > 0) {
+        size_t take = std::min(ChunkSize - chunkLength(), length);
+        chunkUpdate(data, take);
+        data += take;
+        length -= take;
+        if (length == 0) {
+            return;
+        }
+
+        uint32_t cv[8];
+        nodeValue(chunkNode(), cv);
+        pushStack(cv, chunkCounter);
+        startChunk(chunkCounter + 1);
+    }
+
+    // hash the largest aligned subtrees straight from the input, the last chunk stays buffered as it may be the root
+    while (length > ChunkSize) {
+        size_t chunks = 1;
+        while (chunks * 2 * ChunkSize <= length && chunks * 2 <= MaxSubtreeChunks) {
+            chunks *= 2;
+        }
+        while ((chunkCounter & (chunks - 1)) != 0) {
+            chunks /= 2;
+        }
+
+        if (chunks == 1) {
+            uint32_t cv[8];
+            chunkValue(key, mode, data, chunkCounter, cv);
+            pushStack(cv, chunkCounter);
+        } else {
+            uint32_t left[8];
+            uint32_t right[8];
+            subtreeValues(data, chunks, chunkCounter, left, right);
+            pushStack(left, chunkCounter);
+            pushStack(right, chunkCounter + chunks / 2);
+        }
+        chunkCounter += chunks;
+        data += chunks * ChunkSize;
+        length -= chunks * ChunkSize;
+    }
+
+    // keep the tail for the next call
+    if (length > 0) {
+        chunkUpdate(data, length);
+        mergeStack(chunkCounter);
+    }
+}
+
+// last block of chunk
+BLAKE3::Node BLAKE3::chunkNode() const {
+    Node node;
+    uint8_t padded[BlockSize] = {};
+    std::memcpy(padded, buffer, bufferIndex);
+    std::memcpy(node.cv, chunkState, sizeof(node.cv));
+    loadBlock(padded, node.block);
+    node.counter = chunkCounter;
+    node.blockLength = static_cast<uint32_t>(bufferIndex);
+    node.flags = mode | (blocksCompressed == 0 ? ChunkStart : 0) | ChunkEnd;
+    return node;
+}
+
+// parent of two chaining values
+BLAKE3::Node BLAKE3::parentNode(const uint32_t left[8], const uint32_t right[8]) const {
+    Node node;
+    std::memcpy(node.cv, key, sizeof(node.cv));
+    std::memcpy(node.block, left, 8 * sizeof(uint32_t));
+    std::memcpy(node.block + 8, right, 8 * sizeof(uint32_t));
+    node.counter = 0;
+    node.blockLength = BlockSize;
+    node.flags = mode | Parent;
+    return node;
+}
+
+// fold the subtree stack into the root
+BLAKE3::Node BLAKE3::rootNode() const {
+    if (cvStackLength == 0) {
+        return chunkNode();
+    }
+
+    // an empty chunk means the input ended on a subtree boundary, the top two subtrees are the root's children
+    size_t remaining = cvStackLength;
+    Node node;
+    if (chunkLength() > 0) {
+        node = chunkNode();
+    } else {
+        remaining -= 2;
+        node = parentNode(cvStack[remaining], cvStack[remaining + 1]);
+    }
+
+    while (remaining > 0) {
+        --remaining;
+        uint32_t cv[8];
+        nodeValue(node, cv);
+        node = parentNode(cvStack[remaining], cv);
+    }
+    return node;
+}
+
+// chaining value of a node that is not the root
+void BLAKE3::nodeValue(const Node& node, uint32_t cv[8]) {
+    std::memcpy(cv, node.cv, 8 * sizeof(uint32_t));
+    compressInPlace(cv, node.block, node.counter, node.blockLength, node.flags);
+}
+
+// write root output blocks
+void BLAKE3::rootOutput(const Node& node, uint8_t* output, size_t length, uint64_t seek) {
+    uint64_t counter = seek / 64;
+    size_t skip = static_cast<size_t>(seek % 64);
+    while (length > 0) {
+        uint32_t words[16];
+        compress(node.cv, node.block, counter++, node.blockLength, node.flags | Root, words);
+
+        uint8_t bytes[64];
+        for (size_t i = 0; i < 16; ++i) {
+            bytes[i * 4] = static_cast<uint8_t>(words[i]);
+            bytes[i * 4 + 1] = static_cast<uint8_t>(words[i] >> 8);
+            bytes[i * 4 + 2] = static_cast<uint8_t>(words[i] >> 16);
+            bytes[i * 4 + 3] = static_cast<uint8_t>(words[i] >> 24);
+        }
+
+        size_t take = std::min(length, 64 - skip);
+        std::memcpy(output, bytes + skip, take);
+        output += take;
+        length -= take;
+        skip = 0;
+    }
+}
+
+// finalize hash
+std::string BLAKE3::final() {
+    uint8_t digest[OutputSize];
+    final(digest);
+
+    // format hash as hex
+    std::ostringstream result;
+    for (uint8_t byte : digest) {
+        result << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(byte);
+    }
+
+    return result.str();
+}
+
+// finalize binary hash
+void BLAKE3::final(uint8_t digest[OutputSize]) {
+    finalXof(digest, OutputSize);
+}
+
+// finalize extendable output
+void BLAKE3::finalXof(uint8_t* output, size_t length, uint64_t seek) {
+    rootOutput(rootNode(), output, length, seek);
+    reset(); // reset state
+}
+
+// compute binary hash
+void BLAKE3::hash(const uint8_t* data, size_t length, uint8_t digest[OutputSize]) {
+    BLAKE3 blake3;
+    blake3.update(data, length);
+    blake3.final(digest);
+}
+
+// compute hash
+std::string BLAKE3::hash(const std::string& data) {
+    BLAKE3 blake3;
+    blake3.update(data);
+    return blake3.final();
+}
+
+// write streaming state
+void BLAKE3::saveState(HashStateWriter& writer) const {
+    for (uint32_t word : key) {
+        writer.putWord(word, 4);
+    }
+    writer.putWord(mode, 1);
+    for (uint32_t word : chunkState) {
+        writer.putWord(word, 4);
+    }
+    writer.putWord(chunkCounter, 8);
+    writer.putWord(blocksCompressed, 1);
+    writer.putWord(bufferIndex, 1);
+    writer.putBytes(buffer, bufferIndex);
+    writer.putWord(cvStackLength, 1);
+    for (size_t i = 0; i < cvStackLength; ++i) {
+        for (uint32_t word : cvStack[i]) {
+            writer.putWord(word, 4);
+        }
+    }
+}
+
+// restore streaming state
+void BLAKE3::loadState(HashStateReader& reader) {
+    for (uint32_t& word : key) {
+        word = static_cast<uint32_t>(reader.getWord(4));
+    }
+    mode = static_cast<uint32_t>(reader.getWord(1));
+    for (uint32_t& word : chunkState) {
+        word = static_cast<uint32_t>(reader.getWord(4));
+    }
+    chunkCounter = reader.getWord(8);
+    blocksCompressed = static_cast<size_t>(reader.getWord(1));
+    bufferIndex = static_cast<size_t>(reader.getWord(1));
+
+    // a chunk holds at most 15 compressed blocks plus its buffered last block
+    bool validMode = mode == 0 || mode == KeyedHash || mode == DeriveKeyContext || mode == DeriveKeyMaterial;
+    if (!validMode || bufferIndex > BlockSize || blocksCompressed >= ChunkSize / BlockSize ||
+        (blocksCompressed > 0 && bufferIndex == 0)) {
+        throw std::runtime_error("Invalid hash state");
+    }
+    reader.getBytes(buffer, bufferIndex);
+
+    cvStackLength = static_cast<size_t>(reader.getWord(1));
+    if (cvStackLength > MaxDepth) {
+        throw std::runtime_error("Invalid hash state");
+    }
+    for (size_t i = 0; i < cvStackLength; ++i) {
+        for (uint32_t& word : cvStack[i]) {
+            word = static_cast<uint32_t>(reader.getWord(4));
+        }
+    }
+}
@@ -0,0 +1,221 @@
+#include "BlockMatcher.h"
+#include "RollingHash.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept> // Error handling
+
+// filter bits per known block, keeps false candidates near 1 in 64 windows
+static constexpr size_t FilterBitsPerBlock = 64;
+
+// smallest filter, 512 bytes
+static constexpr unsigned MinFilterBits = 12;
+
+// matcher constructor
+BlockMatcher::BlockMatcher(size_t blockSize, HashAlgorithm strong)
+    : window(blockSize), strong(strong), digestLength(HashLite::digestSize(strong)), filterShift(64) {
+    if (blockSize == 0) {
+        throw std::runtime_error("Invalid block size");
+    }
+    growFilter();
+}
+
+// add block from bytes
+size_t BlockMatcher::add(const uint8_t* data) {
+    std::vector<uint8_t> digest(digestLength);
+    strong.computeDigest(data, window, digest.data());
+    return add(Buzhash::hashValue(data, window), digest.data());
+}
+
+// add block from signature
+size_t BlockMatcher::add(uint64_t weak, const uint8_t* digest) {
+    size_t block = weakHashes.size();
+    weakHashes.push_back(weak);
+    digests.insert(digests.end(), digest, digest + digestLength);
+    index.emplace(weak, block);
+
+    if (weakHashes.size() * FilterBitsPerBlock > (static_cast<uint64_t>(1) << (64 - filterShift))) {
+        growFilter();
+    } else {
+        uint64_t bit = weak >> filterShift;
+        filter[bit >> 6] |= static_cast<uint64_t>(1) << (bit & 63);
+    }
+    return block;
+}
+
+// rebuild filter
+void BlockMatcher::growFilter() {
+    unsigned bits = MinFilterBits;
+    while ((static_cast<uint64_t>(1) << bits) < weakHashes.size() * FilterBitsPerBlock) {
+        ++bits;
+    }
+    filterShift = 64 - bits;
+    filter.assign((static_cast<size_t>(1) << bits) / 64, 0);
+    for (uint64_t weak : weakHashes) {
+        uint64_t bit = weak >> filterShift;
+        filter[bit >> 6] |= static_cast<uint64_t>(1) << (bit & 63);
+    }
+}
+
+// non-overlapping matches
+std::vector<BlockMatch> BlockMatcher::scan(const uint8_t* data, size_t length) const {
+    return find(data, length, false);
+}
+
+// all matches
+std::vector<BlockMatch> BlockMatcher::scanAll(const uint8_t* data, size_t length) const {
+    return find(data, length, true);
+}
+
+// windows hashed per pass before the filter is tested
+static constexpr size_t ScanBlock = 4096;
+
+// filter test of one hash
+static inline bool inFilter(const uint64_t* filter, unsigned shift, uint64_t hash) {
+    uint64_t bit = hash >> shift;
+    return (filter[bit >> 6] >> (bit & 63) & 1) != 0;
+}
+
+// positions of hashes that pass the filter, returns their number
+static size_t filterScalar(const uint64_t* hashes, size_t count, const uint64_t* filter, unsigned shift,
+                           uint32_t* candidates) {
+    size_t found = 0;
+    for (size_t i = 0; i < count; ++i) {
+        candidates[found] = static_cast<uint32_t>(i);
+        found += inFilter(filter, shift, hashes[i]) ? 1 : 0;
+    }
+    return found;
+}
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#include <immintrin.h>
+#define MATCH_AVX512 1
+
+// filter test of eight hashes per step, the filter words are gathered and the bits tested together
+__attribute__((target("avx512f")))
+static size_t filterWide(const uint64_t* hashes, size_t count, const uint64_t* filter, unsigned shift,
+                         uint32_t* candidates) {
+    const __m512i low = _mm512_set1_epi64(63);
+    const __m512i one = _mm512_set1_epi64(1);
+    size_t found = 0;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m512i bit = _mm512_srli_epi64(_mm512_loadu_si512(hashes + i), shift);
+        __m512i words = _mm512_i64gather_epi64(_mm512_srli_epi64(bit, 6), reinterpret_cast<const long long*>(filter), 8);
+        __mmask8 hit = _mm512_test_epi64_mask(_mm512_srlv_epi64(words, _mm512_and_si512(bit, low)), one);
+        while (hit != 0) {
+            candidates[found++] = static_cast<uint32_t>(i + __builtin_ctz(hit));
+            hit &= static_cast<__mmask8>(hit - 1);
+        }
+    }
+    for (; i < count; ++i) {
+        if (inFilter(filter, shift, hashes[i])) {
+            candidates[found++] = static_cast<uint32_t>(i);
+        }
+    }
+    return found;
+}
+
+// cpu support of the eight hash filter test
+static bool wideAvailable() {
+    static const bool supported = __builtin_cpu_supports("avx512f");
+    return supported;
+}
+#endif
+
+// positions of hashes that pass the filter
+static size_t filterHashes(const uint64_t* hashes, size_t count, const uint64_t* filter, unsigned shift,
+                           uint32_t* candidates) {
+#ifdef MATCH_AVX512
+    if (wideAvailable()) {
+        return filterWide(hashes, count, filter, shift, candidates);
+    }
+#endif
+    return filterScalar(hashes, count, filter, shift, candidates);
+}
+
+// confirm candidate
+size_t BlockMatcher::confirm(const uint8_t* data, uint64_t weak, uint8_t* digest) const {
+    // the strong digest is computed once per candidate window, the lowest matching index wins
+    bool hashed = false;
+    size_t found = weakHashes.size();
+    auto range = index.equal_range(weak);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (!hashed) {
+            strong.computeDigest(data, window, digest);
+            hashed = true;
+        }
+        if (it->second < found && std::memcmp(digest, digests.data() + it->second * digestLength, digestLength) == 0) {
+            found = it->second;
+        }
+    }
+    return found;
+}
+
+// find matches
+std::vector<BlockMatch> BlockMatcher::find(const uint8_t* data, size_t length, bool overlapping) const {
+    std::vector<BlockMatch> matches;
+    if (length < window) {
+        return matches;
+    }
+
+    // hash a run of windows in one tight loop, then test them all against the filter
+    std::vector<uint64_t> hashes(ScanBlock);
+    std::vector<uint32_t> candidates(ScanBlock);
+    std::vector<uint8_t> digest(digestLength);
+    Buzhash rolling;
+    rolling.add(data, window);
+    size_t position = 0; // window of hashes[0]
+    while (true) {
+        size_t steps = std::min(ScanBlock - 1, length - window - position);
+        hashes[0] = rolling.value();
+        rolling.roll(data + position, steps, hashes.data() + 1);
+
+        // the last hash starts the next run unless the data ends there
+        bool last = position + steps + window == length;
+        size_t tested = last ? steps + 1 : steps;
+        size_t resume = 0;
+        size_t found = filterHashes(hashes.data(), tested, filter.data(), filterShift, candidates.data());
+        for (size_t c = 0; c < found; ++c) {
+            size_t i = candidates[c];
+            size_t block = confirm(data + position + i, hashes[i], digest.data());
+            if (block == weakHashes.size()) {
+                continue;
+            }
+
+            BlockMatch match;
+            match.offset = position + i;
+            match.block = block;
+            matches.push_back(match);
+            if (!overlapping) {
+                resume = position + i + window;
+                break;
+            }
+        }
+
+        if (resume != 0) {
+            // restart after the block
+            if (length - resume < window) {
+                break;
+            }
+            rolling.reset();
+            rolling.add(data + resume, window);
+            position = resume;
+            continue;
+        }
+        if (last) {
+            break;
+        }
+        position += steps;
+    }
+    return matches;
+}
+
+// known blocks
+size_t BlockMatcher::size() const {
+    return weakHashes.size();
+}
+
+// block size
+size_t BlockMatcher::blockSize() const {
+    return window;
+}
@@ -1,41 +1,82 @@
 #include "CRC16.h" // algorithm header
+#include "HashState.h"
+#include "HashLite.h" // batch frames
 #include <sstream> // hash in caps
 #include <iomanip> // hex formating
 #include <cstdint>
 
+static_assert(CRC16XModem::check() == 0x31C3, "CRC-16/XMODEM check value");
+
 // CRC16 constructor
-CRC16::CRC16() {}
+CRC16::CRC16() {
+    reset();
+}
 
-// CRC16 calculation
-uint16_t CRC16::calculate(const std::string& data) const {
-    uint16_t crc = 0x0; // Initialize at 0x0
+// write checksum as big-endian bytes
+void CRC16::hash(const uint8_t* data, size_t length, uint8_t digest[OutputSize]) const {
+    uint16_t crcValue = CRC16XModem::compute(data, length);
+    digest[0] = static_cast<uint8_t>(crcValue >> 8);
+    digest[1] = static_cast<uint8_t>(crcValue);
+}
 
-    // Iterate each byte
-    for (char c : data) {
-        crc ^= (static_cast<uint16_t>(c) << 8); // shift left to align byte
+// checksums of many frames
+void CRC16::hashBatch(const HashInput* frames, size_t count, uint16_t* results) {
+    CRC16XModem::computeBatch(frames, count, results);
+}
 
-        // Process each bit
-        for (int bit = 0; bit < 8; ++bit) {
-            if (crc & 0x8000) {  // Check most significant bit(MSB) is set
-                // if MSB set, shift left and XOR against polynomial
-                crc = (crc << 1) ^ CRC16_CCITT_POLYNOMIAL;
-            } else {
-                // if MSB not set, only shift left
-                crc = crc << 1;
-            }
-        }
-    }
+// reset running checksum
+void CRC16::reset() {
+    engine.reset(); // Initialize at 0x0
+}
 
-    return crc;  // Return crc value
+// update running checksum
+void CRC16::update(const std::string& data) {
+    update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
 }
 
-// return hash
-std::string CRC16::hash(const std::string& input) {
-    uint16_t crcValue = calculate(input);  // calculate hash
+// update running checksum with raw bytes
+void CRC16::update(const uint8_t* data, size_t length) {
+    engine.update(data, length);
+}
+
+// update running checksum with zero bytes
+void CRC16::updateZeros(uint64_t length) {
+    engine.updateZeros(length);
+}
+
+// finalize checksum
+std::string CRC16::final() {
+    std::string result = format(engine.value());
+    reset();
+    return result;
+}
+
+// finalize checksum as big-endian bytes
+void CRC16::final(uint8_t digest[OutputSize]) {
+    engine.final(digest);
+}
+
+// format checksum
+std::string CRC16::format(uint16_t value) {
     std::ostringstream result;
 
     // format hash
-    result << std::uppercase << std::hex << std::setw(4) << std::setfill('0') << crcValue;
+    result << std::uppercase << std::hex << std::setw(4) << std::setfill('0') << value;
+
+    return result.str();
+}
+
+// return hash
+std::string CRC16::hash(const std::string& input) {
+    return format(CRC16XModem::compute(reinterpret_cast<const uint8_t*>(input.data()), input.size()));  // calculate hash
+}
+
+// write streaming state
+void CRC16::saveState(HashStateWriter& writer) const {
+    writer.putWord(engine.state(), sizeof(CRC16XModem::Value));
+}
 
-    return result.str();  // return hash
+// restore streaming state
+void CRC16::loadState(HashStateReader& reader) {
+    engine.setState(static_cast<CRC16XModem::Value>(reader.getWord(sizeof(CRC16XModem::Value))));
 }
@@ -1,46 +1,84 @@
 #include "CRC32.h" // algorithm header
+#include "HashState.h"
+#include "HashLite.h" // batch frames
 #include <iomanip> // hex formating
 #include <sstream> // hash in caps
 #include <cstdint>
 
+static_assert(CRC32ISOHDLC::check() == 0xCBF43926, "CRC-32/ISO-HDLC check value");
+
 // CRC32 constructor
 CRC32::CRC32() {
-    // Initialize table for all bytes
-    for (uint32_t i = 0; i < 256; ++i) {
-        uint32_t crc = i;
-        // Generate table using 0xEDB88320
-        for (uint8_t j = 0; j < 8; ++j) {
-            if (crc & 1) {
-                crc = (crc >> 1) ^ 0xEDB88320; // XOR against polynomial if the LSB is set
-            } else {
-                crc >>= 1; // or only shift bits
-            }
-        }
-        table[i] = crc; // Store results in table
-    }
-}
-
-// CRC32 calculation
-uint32_t CRC32::calculate(const std::string& data) const {
-    uint32_t crc = 0xFFFFFFFF; // Start with 0xFFFFFFFF
-
-    // Iterate each byte
-    for (unsigned char byte : data) {
-        uint8_t index = static_cast<uint8_t>((crc ^ byte) & 0xFF); // index by XOR CRC and byte, then masking 0xFF
-        crc = (crc >> 8) ^ table[index]; // Shift CRC and save to table
-    }
-
-    // Final XOR with 0xFFFFFFFF
-    return crc ^ 0xFFFFFFFF;
+    reset();
 }
 
-// return hash
-std::string CRC32::hash(const std::string& input) {
-    uint32_t crcValue = calculate(input); // Calculate hash
+// write checksum as big-endian bytes
+void CRC32::hash(const uint8_t* data, size_t length, uint8_t digest[OutputSize]) const {
+    uint32_t crcValue = CRC32ISOHDLC::compute(data, length);
+    digest[0] = static_cast<uint8_t>(crcValue >> 24);
+    digest[1] = static_cast<uint8_t>(crcValue >> 16);
+    digest[2] = static_cast<uint8_t>(crcValue >> 8);
+    digest[3] = static_cast<uint8_t>(crcValue);
+}
+
+// checksums of many frames
+void CRC32::hashBatch(const HashInput* frames, size_t count, uint32_t* results) {
+    CRC32ISOHDLC::computeBatch(frames, count, results);
+}
+
+// reset running checksum
+void CRC32::reset() {
+    engine.reset(); // Start with 0xFFFFFFFF
+}
+
+// update running checksum
+void CRC32::update(const std::string& data) {
+    update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+}
+
+// update running checksum with raw bytes
+void CRC32::update(const uint8_t* data, size_t length) {
+    engine.update(data, length);
+}
+
+// update running checksum with zero bytes
+void CRC32::updateZeros(uint64_t length) {
+    engine.updateZeros(length);
+}
+
+// finalize checksum
+std::string CRC32::final() {
+    std::string result = format(engine.value()); // Final XOR with 0xFFFFFFFF
+    reset();
+    return result;
+}
+
+// finalize checksum as big-endian bytes
+void CRC32::final(uint8_t digest[OutputSize]) {
+    engine.final(digest);
+}
+
+// format checksum
+std::string CRC32::format(uint32_t value) {
     std::ostringstream result;
 
     // format hash as hex
-    result << std::uppercase << std::hex << crcValue;
+    result << std::uppercase << std::hex << value;
 
     return result.str(); // return formated hash
 }
+
+// return hash
+std::string CRC32::hash(const std::string& input) {
+    return format(CRC32ISOHDLC::compute(reinterpret_cast<const uint8_t*>(input.data()), input.size())); // Calculate hash
+}
+
+// write streaming state
+void CRC32::saveState(HashStateWriter& writer) const {
+    writer.putWord(engine.state(), sizeof(CRC32ISOHDLC::Value));
+}
+
+// restore streaming state
+void CRC32::loadState(HashStateReader& reader) {
+    engine.setState(static_cast<CRC32ISOHDLC::Value>(reader.getWord(sizeof(CRC32ISOHDLC::Value))));
+}
@@ -0,0 +1,129 @@
+#include "CRC64.h" // algorithm header
+#include "HashState.h"
+#include "HashLite.h" // batch frames
+#include <iomanip> // hex formating
+#include <sstream> // hash in caps
+#include <cstdint>
+
+static_assert(CRC64XZ::check() == 0x995DC9BBDF1939FAULL, "CRC-64/XZ check value");
+static_assert(CRC64ECMA::check() == 0x6C40DF5F0B497347ULL, "CRC-64/ECMA-182 check value");
+static_assert(CRC64NVMe::check() == 0xAE8B14860A799888ULL, "CRC-64/NVME check value");
+
+// CRC64 constructor
+CRC64::CRC64(CRC64Variant variant) : variant(variant) {
+    reset();
+}
+
+// CRC64 calculation
+uint64_t CRC64::calculate(uint64_t crc, const uint8_t* data, size_t length) const {
+    switch (variant) {
+        case CRC64Variant::ECMA: return CRC64ECMA::advance(crc, data, length);
+        case CRC64Variant::NVMe: return CRC64NVMe::advance(crc, data, length);
+        default: return CRC64XZ::advance(crc, data, length);
+    }
+}
+
+// checksum of running register
+uint64_t CRC64::value() const {
+    switch (variant) {
+        case CRC64Variant::ECMA: return CRC64ECMA::finish(crc);
+        case CRC64Variant::NVMe: return CRC64NVMe::finish(crc);
+        default: return CRC64XZ::finish(crc);
+    }
+}
+
+// write checksum as big-endian bytes
+void CRC64::hash(const uint8_t* data, size_t length, uint8_t digest[OutputSize]) const {
+    CRC64 crc64(variant);
+    crc64.update(data, length);
+    crc64.final(digest);
+}
+
+// checksums of many frames
+void CRC64::hashBatch(const HashInput* frames, size_t count, uint64_t* results) const {
+    switch (variant) {
+        case CRC64Variant::ECMA: CRC64ECMA::computeBatch(frames, count, results); break;
+        case CRC64Variant::NVMe: CRC64NVMe::computeBatch(frames, count, results); break;
+        default: CRC64XZ::computeBatch(frames, count, results); break;
+    }
+}
+
+// reset running checksum
+void CRC64::reset() {
+    switch (variant) {
+        case CRC64Variant::ECMA: crc = CRC64ECMA::initialState(); break;
+        case CRC64Variant::NVMe: crc = CRC64NVMe::initialState(); break;
+        default: crc = CRC64XZ::initialState(); break;
+    }
+}
+
+// update running checksum
+void CRC64::update(const std::string& data) {
+    update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+}
+
+// update running checksum with raw bytes
+void CRC64::update(const uint8_t* data, size_t length) {
+    crc = calculate(crc, data, length);
+}
+
+// update running checksum with zero bytes
+void CRC64::updateZeros(uint64_t length) {
+    switch (variant) {
+        case CRC64Variant::ECMA: crc = CRC64ECMA::advanceZeros(crc, length); break;
+        case CRC64Variant::NVMe: crc = CRC64NVMe::advanceZeros(crc, length); break;
+        default: crc = CRC64XZ::advanceZeros(crc, length); break;
+    }
+}
+
+// finalize checksum
+std::string CRC64::final() {
+    std::string result = format(value());
+    reset();
+    return result;
+}
+
+// finalize checksum as big-endian bytes
+void CRC64::final(uint8_t digest[OutputSize]) {
+    uint64_t crcValue = value();
+    for (size_t i = 0; i < OutputSize; ++i) {
+        digest[i] = static_cast<uint8_t>(crcValue >> (56 - 8 * i));
+    }
+    reset();
+}
+
+// combine checksums of two parts
+uint64_t CRC64::combine(CRC64Variant variant, uint64_t crcA, uint64_t crcB, uint64_t lengthB) {
+    switch (variant) {
+        case CRC64Variant::ECMA: return CRC64ECMA::combine(crcA, crcB, lengthB);
+        case CRC64Variant::NVMe: return CRC64NVMe::combine(crcA, crcB, lengthB);
+        default: return CRC64XZ::combine(crcA, crcB, lengthB);
+    }
+}
+
+// format checksum
+std::string CRC64::format(uint64_t value) {
+    std::ostringstream result;
+
+    // format hash as hex, padded to 16 digits
+    result << std::uppercase << std::hex << std::setw(16) << std::setfill('0') << value;
+
+    return result.str();
+}
+
+// return hash
+std::string CRC64::hash(const std::string& input) {
+    CRC64 crc64(variant);
+    crc64.update(input);
+    return crc64.final(); // Calculate hash
+}
+
+// write streaming state
+void CRC64::saveState(HashStateWriter& writer) const {
+    writer.putWord(crc, sizeof(crc));
+}
+
+// restore streaming state
+void CRC64::loadState(HashStateReader& reader) {
+    crc = reader.getWord(sizeof(crc));
+}
@@ -1,41 +1,80 @@
 #include "CRC8.h" // algorithm header
+#include "HashState.h"
+#include "HashLite.h" // batch frames
 #include <sstream>  // implementing hex strings
 #include <iomanip>  // hex formating
 #include <cstdint>
 
+static_assert(CRC8SMBus::check() == 0xF4, "CRC-8/SMBUS check value");
+
 // CRC8 constructor
-CRC8::CRC8() {}
+CRC8::CRC8() {
+    reset();
+}
 
-// CRC8 calculation
-uint8_t CRC8::calculate(const std::string& data) const {
-    uint8_t crc = CRC8_INITIAL; // Initialize algorithm
+// write checksum as binary
+void CRC8::hash(const uint8_t* data, size_t length, uint8_t digest[OutputSize]) const {
+    digest[0] = CRC8SMBus::compute(data, length);
+}
 
-    // iterate each byte of data
-    for (char c : data) {
-        crc ^= static_cast<uint8_t>(c); // XOR byte against crc value
+// checksums of many frames
+void CRC8::hashBatch(const HashInput* frames, size_t count, uint8_t* results) {
+    CRC8SMBus::computeBatch(frames, count, results);
+}
 
-        // Process each bit
-        for (int i = 0; i < 8; ++i) {
-            if (crc & 0x80) {  // check highest bit
-                // Shift left and XOR against CRC8 polynomial
-                crc = (crc << 1) ^ CRC8_POLYNOMIAL;
-            } else {
-                // else shift bits to left
-                crc <<= 1;
-            }
-        }
-    }
+// reset running checksum
+void CRC8::reset() {
+    engine.reset(); // Initialize algorithm
+}
 
-    return crc; // Return CRC value
+// update running checksum
+void CRC8::update(const std::string& data) {
+    update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
 }
 
-// return hash
-std::string CRC8::hash(const std::string& input) {
-    uint8_t crcValue = calculate(input);  // Calculate hash
+// update running checksum with raw bytes
+void CRC8::update(const uint8_t* data, size_t length) {
+    engine.update(data, length);
+}
+
+// update running checksum with zero bytes
+void CRC8::updateZeros(uint64_t length) {
+    engine.updateZeros(length);
+}
+
+// finalize checksum
+std::string CRC8::final() {
+    std::string result = format(engine.value());
+    reset();
+    return result;
+}
+
+// finalize checksum as binary
+void CRC8::final(uint8_t digest[OutputSize]) {
+    engine.final(digest);
+}
+
+// format checksum
+std::string CRC8::format(uint8_t value) {
     std::ostringstream result;
 
     // hash to hex
-    result << std::uppercase << std::hex << static_cast<int>(crcValue);
+    result << std::uppercase << std::hex << static_cast<int>(value);
+
+    return result.str();
+}
+
+// return hash
+std::string CRC8::hash(const std::string& input) {
+    return format(CRC8SMBus::compute(reinterpret_cast<const uint8_t*>(input.data()), input.size()));  // Calculate hash
+}
+
+// write streaming state
+void CRC8::saveState(HashStateWriter& writer) const {
+    writer.putWord(engine.state(), sizeof(CRC8SMBus::Value));
+}
 
-    return result.str();  // return hash
+// restore streaming state
+void CRC8::loadState(HashStateReader& reader) {
+    engine.setState(static_cast<CRC8SMBus::Value>(reader.getWord(sizeof(CRC8SMBus::Value))));
 }
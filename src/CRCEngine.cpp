@@ -0,0 +1,190 @@
+#include "CRCEngine.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define CRC_CLMUL 1
+#endif
+
+#ifdef CRC_CLMUL
+// load block, a normal CRC reads it with the first byte as the highest degree
+__attribute__((target("pclmul,ssse3")))
+static inline __m128i loadBlock(const uint8_t* data, bool reflected) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    if (!reflected) {
+        block = _mm_shuffle_epi8(block, _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+    }
+    return block;
+}
+
+// multiply both halves of block by their constants and add next block
+__attribute__((target("pclmul,ssse3")))
+static inline __m128i foldBlock(__m128i block, __m128i constants, __m128i next) {
+    __m128i low = _mm_clmulepi64_si128(block, constants, 0x00);
+    __m128i high = _mm_clmulepi64_si128(block, constants, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(low, high), next);
+}
+
+// fold with four independent blocks in flight, inputs below 64 bytes fold one block at a time
+__attribute__((target("pclmul,ssse3")))
+static void foldClmul(const uint8_t* data, size_t length, const CRCFoldConstants& constants, bool reflected,
+                      const uint8_t prefix[16], uint8_t result[16]) {
+    __m128i fold4 = _mm_set_epi64x(static_cast<long long>(constants.fold4[1]), static_cast<long long>(constants.fold4[0]));
+    __m128i fold1 = _mm_set_epi64x(static_cast<long long>(constants.fold1[1]), static_cast<long long>(constants.fold1[0]));
+
+    __m128i x = _mm_xor_si128(loadBlock(data, reflected), loadBlock(prefix, reflected));
+    data += 16;
+    length -= 16;
+
+    if (length >= 48) {
+        __m128i x0 = x;
+        __m128i x1 = loadBlock(data, reflected);
+        __m128i x2 = loadBlock(data + 16, reflected);
+        __m128i x3 = loadBlock(data + 32, reflected);
+        data += 48;
+        length -= 48;
+
+        while (length >= 64) {
+            x0 = foldBlock(x0, fold4, loadBlock(data, reflected));
+            x1 = foldBlock(x1, fold4, loadBlock(data + 16, reflected));
+            x2 = foldBlock(x2, fold4, loadBlock(data + 32, reflected));
+            x3 = foldBlock(x3, fold4, loadBlock(data + 48, reflected));
+            data += 64;
+            length -= 64;
+        }
+
+        // merge the four lanes
+        x = foldBlock(x0, fold1, x1);
+        x = foldBlock(x, fold1, x2);
+        x = foldBlock(x, fold1, x3);
+    }
+
+    // remaining blocks
+    while (length >= 16) {
+        x = foldBlock(x, fold1, loadBlock(data, reflected));
+        data += 16;
+        length -= 16;
+    }
+
+    // back to message order, the byte reversal is its own inverse
+    if (!reflected) {
+        x = _mm_shuffle_epi8(x, _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(result), x);
+}
+
+// load four blocks, byte reversed per block for a normal CRC
+__attribute__((target("pclmul,ssse3,avx512f,avx512bw,vpclmulqdq")))
+static inline __m512i loadWide(const uint8_t* data, bool reflected) {
+    __m512i blocks = _mm512_loadu_si512(data);
+    if (!reflected) {
+        const long long low = 0x08090A0B0C0D0E0FLL, high = 0x0001020304050607LL;
+        blocks = _mm512_shuffle_epi8(blocks, _mm512_set_epi64(high, low, high, low, high, low, high, low));
+    }
+    return blocks;
+}
+
+// same constants for all four blocks
+__attribute__((target("pclmul,ssse3,avx512f,avx512bw,vpclmulqdq")))
+static inline __m512i wideConstants(const uint64_t pair[2]) {
+    long long low = static_cast<long long>(pair[0]), high = static_cast<long long>(pair[1]);
+    return _mm512_set_epi64(high, low, high, low, high, low, high, low);
+}
+
+// multiply the halves of four blocks by their constants and add next blocks
+__attribute__((target("pclmul,ssse3,avx512f,avx512bw,vpclmulqdq")))
+static inline __m512i foldWide(__m512i blocks, __m512i constants, __m512i next) {
+    __m512i low = _mm512_clmulepi64_epi128(blocks, constants, 0x00);
+    __m512i high = _mm512_clmulepi64_epi128(blocks, constants, 0x11);
+    return _mm512_ternarylogic_epi64(low, high, next, 0x96); // three way xor
+}
+
+// fold with sixteen blocks in flight in four 512 bit registers, needs at least 256 bytes
+__attribute__((target("pclmul,ssse3,avx512f,avx512bw,vpclmulqdq")))
+static void foldVpclmul(const uint8_t* data, size_t length, const CRCFoldConstants& constants, bool reflected,
+                        const uint8_t prefix[16], uint8_t result[16]) {
+    __m512i fold16 = wideConstants(constants.fold16);
+    __m512i fold4 = wideConstants(constants.fold4);
+    __m128i fold1 = _mm_set_epi64x(static_cast<long long>(constants.fold1[1]), static_cast<long long>(constants.fold1[0]));
+
+    __m512i first = _mm512_zextsi128_si512(loadBlock(prefix, reflected));
+    __m512i z0 = _mm512_xor_si512(loadWide(data, reflected), first);
+    __m512i z1 = loadWide(data + 64, reflected);
+    __m512i z2 = loadWide(data + 128, reflected);
+    __m512i z3 = loadWide(data + 192, reflected);
+    data += 256;
+    length -= 256;
+
+    while (length >= 256) {
+        z0 = foldWide(z0, fold16, loadWide(data, reflected));
+        z1 = foldWide(z1, fold16, loadWide(data + 64, reflected));
+        z2 = foldWide(z2, fold16, loadWide(data + 128, reflected));
+        z3 = foldWide(z3, fold16, loadWide(data + 192, reflected));
+        data += 256;
+        length -= 256;
+    }
+
+    // merge registers, then remaining groups of four blocks
+    __m512i z = foldWide(z0, fold4, z1);
+    z = foldWide(z, fold4, z2);
+    z = foldWide(z, fold4, z3);
+    while (length >= 64) {
+        z = foldWide(z, fold4, loadWide(data, reflected));
+        data += 64;
+        length -= 64;
+    }
+
+    // merge the four blocks of the register, then the remaining blocks
+    __m128i x = _mm512_maskz_extracti32x4_epi32(0xF, z, 0);
+    x = foldBlock(x, fold1, _mm512_maskz_extracti32x4_epi32(0xF, z, 1));
+    x = foldBlock(x, fold1, _mm512_maskz_extracti32x4_epi32(0xF, z, 2));
+    x = foldBlock(x, fold1, _mm512_maskz_extracti32x4_epi32(0xF, z, 3));
+    while (length >= 16) {
+        x = foldBlock(x, fold1, loadBlock(data, reflected));
+        data += 16;
+        length -= 16;
+    }
+
+    if (!reflected) {
+        x = _mm_shuffle_epi8(x, _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(result), x);
+}
+#endif
+
+// inputs from this size take the 512 bit kernel when available
+static constexpr size_t WideThreshold = 1024;
+
+// cpu support of the 512 bit kernel
+static bool wideAvailable() {
+#ifdef CRC_CLMUL
+    static const bool supported = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+                                  __builtin_cpu_supports("vpclmulqdq");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+// cpu support
+bool CRCFold::available() {
+#ifdef CRC_CLMUL
+    static const bool supported = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+// fold blocks
+void CRCFold::fold(const uint8_t* data, size_t length, const CRCFoldConstants& constants, bool reflected,
+                   const uint8_t prefix[16], uint8_t result[16]) {
+#ifdef CRC_CLMUL
+    if (length >= WideThreshold && wideAvailable()) {
+        foldVpclmul(data, length, constants, reflected, prefix, result);
+        return;
+    }
+    foldClmul(data, length, constants, reflected, prefix, result);
+#else
+    (void)data, (void)length, (void)constants, (void)reflected, (void)prefix, (void)result;
+#endif
+}
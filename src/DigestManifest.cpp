@@ -0,0 +1,481 @@
+#include "DigestManifest.h"
+#include "CRCEngine.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <stdexcept> // Error handling
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <atomic>
+#include <windows.h>
+#endif
+
+// create a temporary file with a unique name beside path, so concurrent writers never share one
+static std::FILE* openTemporary(const std::string& path, std::string& temporary) {
+#ifndef _WIN32
+    temporary = path + ".XXXXXX";
+    int fd = ::mkstemp(&temporary[0]);
+    if (fd < 0) {
+        throw std::runtime_error("Unable to write manifest: " + path);
+    }
+    ::fchmod(fd, 0644); // mkstemp creates the file private to the owner
+    std::FILE* file = ::fdopen(fd, "wb");
+    if (file == nullptr) {
+        ::close(fd);
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Unable to write manifest: " + path);
+    }
+    return file;
+#else
+    static std::atomic<unsigned> counter(0);
+    temporary = path + "." + std::to_string(GetCurrentProcessId()) + "." + std::to_string(counter++) + ".tmp";
+    std::FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (file == nullptr) {
+        throw std::runtime_error("Unable to write manifest: " + path);
+    }
+    return file;
+#endif
+}
+
+// replace target with a written file in one step, an existing target stays readable until then
+static bool replaceFile(const std::string& source, const std::string& target) {
+#ifndef _WIN32
+    return ::rename(source.c_str(), target.c_str()) == 0;
+#else
+    return MoveFileExA(source.c_str(), target.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#endif
+}
+
+// manifest header, native byte order, followed by the sections it locates
+struct ManifestHeader {
+    char magic[4];        // "HLDM"
+    uint32_t version;     // format version
+    uint32_t byteOrder;   // 0x01020304 as written by this machine
+    uint32_t algorithm;   // HashAlgorithm value
+    uint32_t digestSize;  // digest bytes per record
+    uint32_t recordSize;  // bytes per record
+    uint64_t count;       // records
+    uint64_t digestOrder; // offset of record numbers sorted by digest
+    uint64_t prefixIndex; // offset of (1 << prefixBits) + 1 positions in digest order
+    uint64_t strings;     // offset of the path string table
+    uint64_t stringsSize; // bytes of the path string table
+    uint32_t prefixBits;  // leading digest bits selecting a prefix bucket
+    uint32_t check;       // CRC-32 of the fields above
+};
+
+static_assert(sizeof(ManifestHeader) == 72, "manifest header layout");
+
+// format version
+static constexpr uint32_t ManifestVersion = 1;
+
+// record layout: path offset (8), path length (4), reserved (4), digest padded to 8 bytes
+static constexpr size_t RecordPath = 0;
+static constexpr size_t RecordPathLength = 8;
+static constexpr size_t RecordDigest = 16;
+
+// bytes per record for a digest size
+static size_t recordSizeOf(size_t digestSize) {
+    return RecordDigest + (digestSize + 7) / 8 * 8;
+}
+
+// checksum of a header
+static uint32_t headerCheck(const ManifestHeader& header) {
+    return CRC32ISOHDLC::compute(reinterpret_cast<const uint8_t*>(&header), offsetof(ManifestHeader, check));
+}
+
+// leading 16 bits of a digest, short digests are padded with zeros
+static uint32_t digestPrefix(const uint8_t* digest, size_t size, unsigned bits) {
+    uint32_t leading = (static_cast<uint32_t>(digest[0]) << 8) | (size > 1 ? digest[1] : 0);
+    return leading >> (16 - bits);
+}
+
+// value of a hex digit, -1 if not a digit
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// writer constructor
+DigestManifestWriter::DigestManifestWriter(HashAlgorithm algorithm)
+    : algorithm(algorithm), digestSize(HashLite::digestSize(algorithm)) {}
+
+// add entry
+void DigestManifestWriter::add(const std::string& path, const uint8_t* digest) {
+    paths.push_back(path);
+    digests.insert(digests.end(), digest, digest + digestSize);
+}
+
+// add entries of a text manifest
+void DigestManifestWriter::addText(const std::string& textPath) {
+    std::ifstream file(textPath, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Unable to open file: " + textPath);
+    }
+
+    std::vector<uint8_t> digest(digestSize);
+    std::string line;
+    for (size_t number = 1; std::getline(file, line); ++number) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty()) {
+            continue;
+        }
+
+        // a leading backslash marks a name with escaped backslashes and newlines
+        bool escaped = line[0] == '\\';
+        size_t hex = escaped ? 1 : 0;
+        size_t name = hex + 2 * digestSize + 2;
+        if (line.size() < name || line[name - 2] != ' ' || (line[name - 1] != ' ' && line[name - 1] != '*')) {
+            throw std::runtime_error("Invalid checksum line " + std::to_string(number) + " in " + textPath);
+        }
+        for (size_t i = 0; i < digestSize; ++i) {
+            int high = hexValue(line[hex + 2 * i]);
+            int low = hexValue(line[hex + 2 * i + 1]);
+            if (high < 0 || low < 0) {
+                throw std::runtime_error("Invalid checksum line " + std::to_string(number) + " in " + textPath);
+            }
+            digest[i] = static_cast<uint8_t>(high << 4 | low);
+        }
+
+        std::string path;
+        for (size_t i = name; i < line.size(); ++i) {
+            if (escaped && line[i] == '\\' && i + 1 < line.size()) {
+                char next = line[++i];
+                path += next == 'n' ? '\n' : next == 'r' ? '\r' : next;
+            } else {
+                path += line[i];
+            }
+        }
+        add(path, digest.data());
+    }
+    if (file.bad()) {
+        throw std::runtime_error("Unable to read file: " + textPath);
+    }
+}
+
+// number of entries
+size_t DigestManifestWriter::size() const {
+    return paths.size();
+}
+
+// write manifest
+void DigestManifestWriter::write(const std::string& path) const {
+    // entries in path order, the last added entry of a path wins
+    std::vector<size_t> order(paths.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) { return paths[a] < paths[b]; });
+    std::vector<size_t> entries;
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (i + 1 < order.size() && paths[order[i]] == paths[order[i + 1]]) {
+            continue;
+        }
+        entries.push_back(order[i]);
+    }
+    size_t count = entries.size();
+
+    // records and string table
+    size_t recordSize = recordSizeOf(digestSize);
+    std::vector<uint8_t> records(count * recordSize);
+    std::string strings;
+    for (size_t r = 0; r < count; ++r) {
+        const std::string& name = paths[entries[r]];
+        uint64_t offset = strings.size();
+        uint32_t length = static_cast<uint32_t>(name.size());
+        std::memcpy(records.data() + r * recordSize + RecordPath, &offset, sizeof(offset));
+        std::memcpy(records.data() + r * recordSize + RecordPathLength, &length, sizeof(length));
+        std::memcpy(records.data() + r * recordSize + RecordDigest, digests.data() + entries[r] * digestSize, digestSize);
+        strings += name;
+    }
+
+    // record numbers in digest order
+    auto digestOf = [&](uint64_t r) { return records.data() + r * recordSize + RecordDigest; };
+    std::vector<uint64_t> byDigest(count);
+    std::iota(byDigest.begin(), byDigest.end(), 0);
+    std::sort(byDigest.begin(), byDigest.end(), [&](uint64_t a, uint64_t b) {
+        int order = std::memcmp(digestOf(a), digestOf(b), digestSize);
+        return order < 0 || (order == 0 && a < b);
+    });
+
+    // about one record per prefix bucket, at most 16 bits
+    unsigned bits = 0;
+    while (bits < 16 && (static_cast<size_t>(2) << bits) <= count) {
+        ++bits;
+    }
+    std::vector<uint64_t> prefixes((static_cast<size_t>(1) << bits) + 1);
+    for (size_t p = 0, position = 0; p < prefixes.size(); ++p) {
+        while (position < count && digestPrefix(digestOf(byDigest[position]), digestSize, bits) < p) {
+            ++position;
+        }
+        prefixes[p] = position;
+    }
+
+    ManifestHeader header{};
+    std::memcpy(header.magic, "HLDM", 4);
+    header.version = ManifestVersion;
+    header.byteOrder = 0x01020304;
+    header.algorithm = static_cast<uint32_t>(algorithm);
+    header.digestSize = static_cast<uint32_t>(digestSize);
+    header.recordSize = static_cast<uint32_t>(recordSize);
+    header.count = count;
+    header.digestOrder = sizeof(header) + records.size();
+    header.prefixIndex = header.digestOrder + count * sizeof(uint64_t);
+    header.strings = header.prefixIndex + prefixes.size() * sizeof(uint64_t);
+    header.stringsSize = strings.size();
+    header.prefixBits = bits;
+    header.check = headerCheck(header);
+
+    // write beside the target under a unique name and rename, readers never see a partial manifest
+    std::string temporary;
+    std::FILE* file = openTemporary(path, temporary);
+    bool written = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   std::fwrite(records.data(), 1, records.size(), file) == records.size() &&
+                   std::fwrite(byDigest.data(), sizeof(uint64_t), count, file) == count &&
+                   std::fwrite(prefixes.data(), sizeof(uint64_t), prefixes.size(), file) == prefixes.size() &&
+                   std::fwrite(strings.data(), 1, strings.size(), file) == strings.size();
+    written = std::fclose(file) == 0 && written;
+    if (!written || !replaceFile(temporary, path)) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Unable to write manifest: " + path);
+    }
+}
+
+// manifest constructor
+DigestManifest::DigestManifest(const std::string& path) : data(nullptr), length(0), mapped(false) {
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat info;
+    if (fd < 0 || ::fstat(fd, &info) != 0) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        throw std::runtime_error("Unable to open file: " + path);
+    }
+    length = static_cast<size_t>(info.st_size);
+    if (length >= sizeof(ManifestHeader)) {
+        void* address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+            data = static_cast<const uint8_t*>(address);
+            mapped = true;
+        }
+    }
+    ::close(fd);
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Unable to open file: " + path);
+    }
+    buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    data = buffer.data();
+    length = buffer.size();
+#endif
+
+    // every section must lie where the header says, record contents are checked on access
+    ManifestHeader header{};
+    bool valid = data != nullptr && length >= sizeof(header);
+    if (valid) {
+        std::memcpy(&header, data, sizeof(header));
+        valid = std::memcmp(header.magic, "HLDM", 4) == 0 && header.version == ManifestVersion &&
+                header.byteOrder == 0x01020304 && header.check == headerCheck(header) && header.prefixBits <= 16;
+    }
+    if (valid) {
+        try {
+            valid = header.digestSize == HashLite::digestSize(static_cast<HashAlgorithm>(header.algorithm));
+        } catch (const std::runtime_error&) {
+            valid = false; // unknown algorithm
+        }
+    }
+    if (valid) {
+        recordSize = header.recordSize;
+        count = static_cast<size_t>(header.count);
+        valid = recordSize == recordSizeOf(header.digestSize) && header.count <= length / recordSize &&
+                header.digestOrder == sizeof(header) + header.count * recordSize &&
+                header.prefixIndex == header.digestOrder + header.count * sizeof(uint64_t) &&
+                header.strings == header.prefixIndex + ((uint64_t(1) << header.prefixBits) + 1) * sizeof(uint64_t) &&
+                header.strings <= length && header.stringsSize == length - header.strings;
+    }
+    if (!valid) {
+#ifndef _WIN32
+        if (mapped) {
+            ::munmap(const_cast<uint8_t*>(data), length);
+        }
+#endif
+        throw std::runtime_error("Invalid digest manifest: " + path);
+    }
+
+    digestLength = header.digestSize;
+    digestOrder = header.digestOrder;
+    prefixIndex = header.prefixIndex;
+    strings = header.strings;
+    stringsSize = header.stringsSize;
+    prefixBits = header.prefixBits;
+}
+
+// manifest destructor
+DigestManifest::~DigestManifest() {
+#ifndef _WIN32
+    if (mapped) {
+        ::munmap(const_cast<uint8_t*>(data), length);
+    }
+#endif
+}
+
+// algorithm
+HashAlgorithm DigestManifest::algorithm() const {
+    ManifestHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    return static_cast<HashAlgorithm>(header.algorithm);
+}
+
+// digest size
+size_t DigestManifest::digestSize() const {
+    return digestLength;
+}
+
+// entry count
+size_t DigestManifest::size() const {
+    return count;
+}
+
+// record bytes
+const uint8_t* DigestManifest::record(size_t i) const {
+    return data + sizeof(ManifestHeader) + i * recordSize;
+}
+
+// entry path
+std::string_view DigestManifest::path(size_t i) const {
+    uint64_t offset;
+    uint32_t pathLength;
+    std::memcpy(&offset, record(i) + RecordPath, sizeof(offset));
+    std::memcpy(&pathLength, record(i) + RecordPathLength, sizeof(pathLength));
+    if (offset > stringsSize || pathLength > stringsSize - offset) {
+        throw std::runtime_error("Invalid digest manifest entry");
+    }
+    return std::string_view(reinterpret_cast<const char*>(data + strings + offset), pathLength);
+}
+
+// entry digest
+const uint8_t* DigestManifest::digest(size_t i) const {
+    return record(i) + RecordDigest;
+}
+
+// binary search by path
+size_t DigestManifest::find(std::string_view target) const {
+    size_t low = 0, high = count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        int order = path(middle).compare(target);
+        if (order == 0) {
+            return middle;
+        }
+        if (order < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return npos;
+}
+
+// search by digest
+std::vector<size_t> DigestManifest::findDigest(const uint8_t* target) const {
+    size_t size = digestSize();
+    uint32_t prefix = digestPrefix(target, size, prefixBits);
+    uint64_t begin, end;
+    std::memcpy(&begin, data + prefixIndex + prefix * sizeof(uint64_t), sizeof(begin));
+    std::memcpy(&end, data + prefixIndex + (prefix + 1) * sizeof(uint64_t), sizeof(end));
+    if (begin > end || end > count) {
+        throw std::runtime_error("Invalid digest manifest index");
+    }
+
+    // record number at a position in digest order
+    auto recordAt = [this](uint64_t position) {
+        uint64_t r;
+        std::memcpy(&r, data + digestOrder + position * sizeof(uint64_t), sizeof(r));
+        if (r >= count) {
+            throw std::runtime_error("Invalid digest manifest index");
+        }
+        return static_cast<size_t>(r);
+    };
+
+    // first match within the bucket
+    while (begin < end) {
+        uint64_t middle = begin + (end - begin) / 2;
+        if (std::memcmp(digest(recordAt(middle)), target, size) < 0) {
+            begin = middle + 1;
+        } else {
+            end = middle;
+        }
+    }
+
+    std::vector<size_t> matches;
+    for (uint64_t position = begin; position < count; ++position) {
+        size_t r = recordAt(position);
+        if (std::memcmp(digest(r), target, size) != 0) {
+            break;
+        }
+        matches.push_back(r);
+    }
+    return matches;
+}
+
+// write text manifest
+void DigestManifest::writeText(const std::string& textPath) const {
+    std::ofstream file(textPath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Unable to open file: " + textPath);
+    }
+
+    static const char digits[] = "0123456789abcdef";
+    size_t size = digestSize();
+    std::string line;
+    for (size_t i = 0; i < count; ++i) {
+        std::string_view name = path(i);
+        bool escape = name.find_first_of("\\\n\r") != std::string_view::npos;
+
+        line.clear();
+        if (escape) {
+            line += '\\';
+        }
+        const uint8_t* bytes = digest(i);
+        for (size_t b = 0; b < size; ++b) {
+            line += digits[bytes[b] >> 4];
+            line += digits[bytes[b] & 0x0F];
+        }
+        line += "  ";
+        for (char c : name) {
+            if (escape && (c == '\\' || c == '\n' || c == '\r')) {
+                line += '\\';
+                line += c == '\n' ? 'n' : c == '\r' ? 'r' : '\\';
+            } else {
+                line += c;
+            }
+        }
+        line += '\n';
+        file.write(line.data(), static_cast<std::streamsize>(line.size()));
+    }
+    if (!file) {
+        throw std::runtime_error("Unable to write file: " + textPath);
+    }
+}
+
+// verify listed files
+size_t DigestManifest::verify(uint64_t* failures) const {
+    size_t size = digestSize();
+    std::vector<std::string> paths(count);
+    std::vector<uint8_t> expected(count * size);
+    for (size_t i = 0; i < count; ++i) {
+        paths[i] = std::string(path(i));
+        std::memcpy(expected.data() + i * size, digest(i), size);
+    }
+    return HashLite(algorithm()).verifyFiles(paths, expected.data(), failures);
+}
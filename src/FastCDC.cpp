@@ -0,0 +1,187 @@
+#include "FastCDC.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <stdexcept> // Error handling
+
+// gear table, fixed pseudo-random values so chunk boundaries never change between versions
+static constexpr std::array<uint64_t, 256> makeGear() {
+    std::array<uint64_t, 256> table{};
+    uint64_t state = 0x0046617374434443ULL; // "FastCDC"
+    for (uint64_t& value : table) {
+        state += 0x9E3779B97F4A7C15ULL;
+        uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        value = z ^ (z >> 31);
+    }
+    return table;
+}
+
+static constexpr std::array<uint64_t, 256> Gear = makeGear();
+
+// mask of the top bits of the hash, which depend on all of the last 64 bytes
+static uint64_t topBits(unsigned bits) {
+    return bits == 0 ? 0 : ~0ULL << (64 - bits);
+}
+
+// first boundary in [begin, end), the hash starts empty at begin
+// the bits tested depend on the last 64 bytes only, each step shifts one older byte out
+static size_t findCut(const uint8_t* data, size_t begin, size_t normal, size_t end, uint64_t maskSmall,
+                      uint64_t maskLarge) {
+    uint64_t hash = 0;
+    size_t i = begin;
+    for (; i < normal; ++i) {
+        hash = (hash << 1) + Gear[data[i]];
+        if ((hash & maskSmall) == 0) {
+            return i + 1;
+        }
+    }
+    for (; i < end; ++i) {
+        hash = (hash << 1) + Gear[data[i]];
+        if ((hash & maskLarge) == 0) {
+            return i + 1;
+        }
+    }
+    return end;
+}
+
+// chunker constructor
+FastCDC::FastCDC(const FastCDCOptions& options) : limits(options) {
+    const FastCDCOptions& o = options;
+    if (o.minSize < 64 || o.avgSize < 256 || (o.avgSize & (o.avgSize - 1)) != 0 || o.minSize > o.avgSize ||
+        o.maxSize < o.avgSize || o.normalization > 3) {
+        throw std::runtime_error("Invalid chunk sizes");
+    }
+
+    unsigned bits = 0;
+    while ((static_cast<size_t>(1) << bits) < o.avgSize) {
+        ++bits;
+    }
+    maskSmall = topBits(bits + o.normalization);
+    maskLarge = topBits(bits - o.normalization);
+}
+
+// first chunk length
+size_t FastCDC::cut(const uint8_t* data, size_t length) const {
+    if (length <= limits.minSize) {
+        return length;
+    }
+    size_t end = std::min(length, limits.maxSize);
+    size_t normal = std::min(limits.avgSize, end);
+    return findCut(data, limits.minSize, normal, end, maskSmall, maskLarge);
+}
+
+// boundaries of an input
+std::vector<ContentChunk> FastCDC::boundaries(const uint8_t* data, size_t length) const {
+    std::vector<ContentChunk> chunks;
+    for (size_t offset = 0; offset < length;) {
+        ContentChunk chunk;
+        chunk.offset = offset;
+        chunk.length = cut(data + offset, length - offset);
+        offset += chunk.length;
+        chunks.push_back(std::move(chunk));
+    }
+    return chunks;
+}
+
+// digest chunks of one buffer as a batch
+static void digestChunks(HashAlgorithm algorithm, const uint8_t* base, uint64_t baseOffset,
+                         std::vector<ContentChunk>& chunks, ThreadPool& pool) {
+    HashLite hasher(algorithm);
+    size_t size = hasher.digestSize();
+    std::vector<HashInput> inputs(chunks.size());
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        inputs[i] = {base + (chunks[i].offset - baseOffset), chunks[i].length};
+    }
+
+    std::vector<uint8_t> digests(chunks.size() * size);
+    hasher.computeBatch(inputs.data(), inputs.size(), digests.data(), pool);
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        chunks[i].digest.assign(digests.begin() + i * size, digests.begin() + (i + 1) * size);
+    }
+}
+
+// chunk and digest on shared pool
+std::vector<ContentChunk> FastCDC::split(HashAlgorithm algorithm, const uint8_t* data, size_t length) const {
+    return split(algorithm, data, length, ThreadPool::shared());
+}
+
+// chunk and digest on given pool
+std::vector<ContentChunk> FastCDC::split(HashAlgorithm algorithm, const uint8_t* data, size_t length,
+                                         ThreadPool& pool) const {
+    std::vector<ContentChunk> chunks = boundaries(data, length);
+    digestChunks(algorithm, data, 0, chunks, pool);
+    return chunks;
+}
+
+// chunk a stream
+void FastCDC::splitStream(HashAlgorithm algorithm, const std::function<size_t(uint8_t* buffer, size_t capacity)>& source,
+                          const ChunkCallback& onChunk) const {
+    HashLite::digestSize(algorithm); // reject unsupported algorithms before reading
+
+    // enough chunks per buffer to keep the pool busy
+    std::vector<uint8_t> buffer(std::max<size_t>(limits.maxSize * 16, 4 << 20));
+    size_t filled = 0;
+    uint64_t position = 0; // input offset of buffer[0]
+    bool ended = false;
+
+    while (!ended || filled > 0) {
+        while (!ended && filled < buffer.size()) {
+            size_t count = source(buffer.data() + filled, buffer.size() - filled);
+            if (count == 0) {
+                ended = true;
+            } else {
+                filled += std::min(count, buffer.size() - filled);
+            }
+        }
+
+        // a chunk that reaches the end of the buffer may still grow unless the input ended or it is full size
+        std::vector<ContentChunk> chunks;
+        size_t offset = 0;
+        while (offset < filled) {
+            size_t length = cut(buffer.data() + offset, filled - offset);
+            if (offset + length == filled && !ended && length < limits.maxSize) {
+                break;
+            }
+            ContentChunk chunk;
+            chunk.offset = position + offset;
+            chunk.length = length;
+            chunks.push_back(std::move(chunk));
+            offset += length;
+        }
+
+        digestChunks(algorithm, buffer.data(), position, chunks, ThreadPool::shared());
+        for (const ContentChunk& chunk : chunks) {
+            onChunk(chunk, buffer.data() + (chunk.offset - position));
+        }
+
+        // keep the unfinished chunk for the next read
+        std::memmove(buffer.data(), buffer.data() + offset, filled - offset);
+        filled -= offset;
+        position += offset;
+    }
+}
+
+// chunk a file
+void FastCDC::splitFile(HashAlgorithm algorithm, const std::string& path, const ChunkCallback& onChunk) const {
+    std::ifstream file(path, std::ios::binary); // open file as binary
+    if (!file) {
+        throw std::runtime_error("Unable to open file: " + path);
+    }
+
+    splitStream(algorithm, [&file, &path](uint8_t* buffer, size_t capacity) {
+        file.read(reinterpret_cast<char*>(buffer), static_cast<std::streamsize>(capacity));
+        if (file.bad()) {
+            throw std::runtime_error("Unable to read file: " + path);
+        }
+        return static_cast<size_t>(file.gcount());
+    }, onChunk);
+}
+
+// options
+const FastCDCOptions& FastCDC::options() const {
+    return limits;
+}
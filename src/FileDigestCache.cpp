@@ -0,0 +1,458 @@
+#include "FileDigestCache.h"
+#include "CRCEngine.h"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept> // Error handling
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// cache file header, native byte order
+struct CacheHeader {
+    char magic[4];       // "HLDC"
+    uint32_t version;    // format version
+    uint32_t byteOrder;  // 0x01020304 as written by this machine
+    uint32_t recordSize; // bytes per record
+    uint64_t slots;      // records in the table, a power of two
+    uint32_t check;      // CRC-32 of the fields above
+    uint32_t reserved;
+    uint64_t used;       // slots in use, only a hint for growing
+    uint8_t padding[24];
+};
+
+// cache record, an all-zero record is an empty slot
+struct CacheRecord {
+    uint64_t device;
+    uint64_t inode;
+    uint64_t size;
+    int64_t mtime;       // nanoseconds since the epoch
+    uint32_t algorithm;  // HashAlgorithm value + 1, 0 for an empty slot
+    uint32_t length;     // digest bytes
+    uint8_t digest[64];
+    uint32_t check;      // CRC-32 of the fields above
+    uint32_t reserved;
+};
+
+static_assert(sizeof(CacheHeader) == 64, "cache header layout");
+static_assert(sizeof(CacheRecord) == 112, "cache record layout");
+
+// format version
+static constexpr uint32_t CacheVersion = 1;
+
+// slots of a new table
+static constexpr uint64_t InitialSlots = 1 << 14;
+
+// files modified this recently are not cached, a later write in the same timestamp tick would go unnoticed
+static constexpr int64_t RacyWindow = 2000000000;
+
+// checksum of a header
+static uint32_t headerCheck(const CacheHeader& header) {
+    return CRC32ISOHDLC::compute(reinterpret_cast<const uint8_t*>(&header), offsetof(CacheHeader, check));
+}
+
+// checksum of a record
+static uint32_t recordCheck(const CacheRecord& record) {
+    return CRC32ISOHDLC::compute(reinterpret_cast<const uint8_t*>(&record), offsetof(CacheRecord, check));
+}
+
+// first slot of a key
+static uint64_t slotOf(uint64_t device, uint64_t inode, uint32_t algorithm, uint64_t slots) {
+    uint64_t x = inode ^ (device * 0x9E3779B97F4A7C15ULL) ^ (static_cast<uint64_t>(algorithm) << 56);
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return (x ^ (x >> 31)) & (slots - 1);
+}
+
+#ifndef _WIN32
+// modification time in nanoseconds
+static int64_t modifiedNs(const struct stat& info) {
+#ifdef __APPLE__
+    return static_cast<int64_t>(info.st_mtimespec.tv_sec) * 1000000000 + info.st_mtimespec.tv_nsec;
+#else
+    return static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+#endif
+}
+
+// take an exclusive lock, retrying when a signal interrupts the wait
+static bool lockFile(int fd) {
+    int result;
+    do {
+        result = ::flock(fd, LOCK_EX);
+    } while (result != 0 && errno == EINTR);
+    return result == 0;
+}
+
+// holds an exclusive lock on a file descriptor
+class FileLock {
+public:
+    explicit FileLock(int& fd) : fd(fd), locked(lockFile(fd)) {}
+
+    ~FileLock() {
+        if (locked) {
+            ::flock(fd, LOCK_UN);
+        }
+    }
+
+    // whether the lock was acquired
+    bool held() const {
+        return locked;
+    }
+
+private:
+    // follows the descriptor when the cache reopens the file
+    int& fd;
+
+    // lock acquired
+    bool locked;
+};
+
+// cache constructor
+FileDigestCache::FileDigestCache(const std::string& path) : cachePath(path), fd(-1), mapping(nullptr), mappingSize(0) {
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Unable to open digest cache: " + path);
+    }
+    try {
+        FileLock lock(fd);
+        if (!lock.held()) {
+            throw std::runtime_error("Unable to lock digest cache: " + path);
+        }
+        map();
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+}
+
+// cache destructor
+FileDigestCache::~FileDigestCache() {
+    unmap();
+}
+
+// map table
+void FileDigestCache::map() {
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        throw std::runtime_error("Unable to open digest cache: " + cachePath);
+    }
+
+    // recreate anything that is not a complete table of this version
+    CacheHeader header;
+    bool valid = static_cast<size_t>(info.st_size) >= sizeof(header) &&
+                 ::pread(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) &&
+                 std::memcmp(header.magic, "HLDC", 4) == 0 && header.version == CacheVersion &&
+                 header.byteOrder == 0x01020304 && header.recordSize == sizeof(CacheRecord) &&
+                 header.check == headerCheck(header) && header.slots != 0 && (header.slots & (header.slots - 1)) == 0 &&
+                 static_cast<uint64_t>(info.st_size) == sizeof(header) + header.slots * sizeof(CacheRecord);
+    if (!valid) {
+        initialize(fd, InitialSlots);
+        info.st_size = static_cast<off_t>(sizeof(header) + InitialSlots * sizeof(CacheRecord));
+    }
+
+    void* address = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) {
+        throw std::runtime_error("Unable to map digest cache: " + cachePath);
+    }
+    mapping = static_cast<uint8_t*>(address);
+    mappingSize = static_cast<size_t>(info.st_size);
+}
+
+// unmap table
+void FileDigestCache::unmap() {
+    if (mapping) {
+        ::munmap(mapping, mappingSize);
+        mapping = nullptr;
+        mappingSize = 0;
+    }
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+// follow a table another process renamed over ours
+bool FileDigestCache::reopenIfReplaced() {
+    for (;;) {
+        struct stat current, named;
+        if (::fstat(fd, &current) != 0 || ::stat(cachePath.c_str(), &named) != 0 ||
+            (current.st_dev == named.st_dev && current.st_ino == named.st_ino)) {
+            return true;
+        }
+
+        int next = ::open(cachePath.c_str(), O_RDWR | O_CLOEXEC);
+        if (next < 0) {
+            return true; // keep writing to the table we have
+        }
+        if (!lockFile(next)) {
+            ::close(next);
+            return false;
+        }
+
+        // switch only once the new table is mapped, map leaves mapping untouched when it throws
+        int previous = fd;
+        uint8_t* previousMapping = mapping;
+        size_t previousSize = mappingSize;
+        fd = next;
+        try {
+            map();
+        } catch (const std::runtime_error&) {
+            ::close(next);
+            fd = previous;
+            return false;
+        }
+        ::flock(previous, LOCK_UN);
+        ::munmap(previousMapping, previousSize);
+        ::close(previous);
+    }
+}
+
+// write empty table
+void FileDigestCache::initialize(int file, uint64_t slots) {
+    CacheHeader header{};
+    std::memcpy(header.magic, "HLDC", 4);
+    header.version = CacheVersion;
+    header.byteOrder = 0x01020304;
+    header.recordSize = sizeof(CacheRecord);
+    header.slots = slots;
+    header.check = headerCheck(header);
+
+    // truncating first zeroes every record
+    off_t size = static_cast<off_t>(sizeof(header) + slots * sizeof(CacheRecord));
+    if (::ftruncate(file, 0) != 0 || ::ftruncate(file, size) != 0 ||
+        ::pwrite(file, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) {
+        throw std::runtime_error("Unable to write digest cache: " + cachePath);
+    }
+}
+
+// rehash into a table twice the size
+void FileDigestCache::grow() {
+    const CacheHeader* header = reinterpret_cast<const CacheHeader*>(mapping);
+    const CacheRecord* records = reinterpret_cast<const CacheRecord*>(mapping + sizeof(CacheHeader));
+    uint64_t slots = header->slots * 2;
+
+    // build the new table under a temporary name, other processes only see it once complete
+    std::string temporary = cachePath + ".tmp";
+    int next = ::open(temporary.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (next < 0) {
+        throw std::runtime_error("Unable to write digest cache: " + temporary);
+    }
+    if (!lockFile(next)) {
+        ::close(next);
+        ::unlink(temporary.c_str());
+        throw std::runtime_error("Unable to lock digest cache: " + temporary);
+    }
+    size_t size = sizeof(CacheHeader) + slots * sizeof(CacheRecord);
+    void* address = MAP_FAILED;
+    try {
+        initialize(next, slots);
+        address = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, next, 0);
+        if (address == MAP_FAILED) {
+            throw std::runtime_error("Unable to map digest cache: " + temporary);
+        }
+    } catch (...) {
+        ::close(next);
+        ::unlink(temporary.c_str());
+        throw;
+    }
+
+    CacheHeader* nextHeader = static_cast<CacheHeader*>(address);
+    CacheRecord* nextRecords = reinterpret_cast<CacheRecord*>(static_cast<uint8_t*>(address) + sizeof(CacheHeader));
+    for (uint64_t i = 0; i < header->slots; ++i) {
+        const CacheRecord& record = records[i];
+        if (record.algorithm == 0 || record.check != recordCheck(record)) {
+            continue; // empty or torn
+        }
+        uint64_t slot = slotOf(record.device, record.inode, record.algorithm, slots);
+        while (nextRecords[slot].algorithm != 0) {
+            slot = (slot + 1) & (slots - 1);
+        }
+        nextRecords[slot] = record;
+        nextHeader->used += 1;
+    }
+    ::msync(address, size, MS_SYNC);
+
+    if (::rename(temporary.c_str(), cachePath.c_str()) != 0) {
+        ::munmap(address, size);
+        ::close(next);
+        ::unlink(temporary.c_str());
+        throw std::runtime_error("Unable to write digest cache: " + cachePath);
+    }
+
+    // the old descriptor and its lock go away with the old table
+    ::munmap(mapping, mappingSize);
+    ::close(fd);
+    fd = next;
+    mapping = static_cast<uint8_t*>(address);
+    mappingSize = size;
+}
+
+// find record
+bool FileDigestCache::lookup(uint64_t device, uint64_t inode, uint64_t size, int64_t mtime, HashAlgorithm algorithm,
+                             uint8_t* digest) const {
+    const CacheHeader* header = reinterpret_cast<const CacheHeader*>(mapping);
+    const CacheRecord* records = reinterpret_cast<const CacheRecord*>(mapping + sizeof(CacheHeader));
+    uint32_t id = static_cast<uint32_t>(algorithm) + 1;
+    size_t length = HashLite::digestSize(algorithm);
+
+    uint64_t slot = slotOf(device, inode, id, header->slots);
+    for (uint64_t probe = 0; probe < header->slots; ++probe, slot = (slot + 1) & (header->slots - 1)) {
+        CacheRecord record = records[slot]; // copy, another process may be writing the slot
+        if (record.algorithm == 0) {
+            return false;
+        }
+        if (record.device == device && record.inode == inode && record.algorithm == id &&
+            record.check == recordCheck(record)) {
+            if (record.size != size || record.mtime != mtime || record.length != length) {
+                return false; // file changed since it was cached
+            }
+            std::memcpy(digest, record.digest, length);
+            return true;
+        }
+    }
+    return false;
+}
+
+// write record
+void FileDigestCache::store(uint64_t device, uint64_t inode, uint64_t size, int64_t mtime, HashAlgorithm algorithm,
+                            const uint8_t* digest, size_t length) {
+    CacheHeader* header = reinterpret_cast<CacheHeader*>(mapping);
+    if ((header->used + 1) * 4 > header->slots * 3) {
+        grow();
+        header = reinterpret_cast<CacheHeader*>(mapping);
+    }
+    CacheRecord* records = reinterpret_cast<CacheRecord*>(mapping + sizeof(CacheHeader));
+
+    CacheRecord record{};
+    record.device = device;
+    record.inode = inode;
+    record.size = size;
+    record.mtime = mtime;
+    record.algorithm = static_cast<uint32_t>(algorithm) + 1;
+    record.length = static_cast<uint32_t>(length);
+    std::memcpy(record.digest, digest, length);
+    record.check = recordCheck(record);
+
+    // same key replaces its record, otherwise take the first torn or empty slot
+    uint64_t slot = slotOf(device, inode, record.algorithm, header->slots);
+    uint64_t target = header->slots;
+    for (uint64_t probe = 0; probe < header->slots; ++probe, slot = (slot + 1) & (header->slots - 1)) {
+        const CacheRecord& current = records[slot];
+        if (current.algorithm == 0) {
+            if (target == header->slots) {
+                target = slot;
+                header->used += 1;
+            }
+            break;
+        }
+        bool torn = current.check != recordCheck(current);
+        if (!torn && current.device == device && current.inode == inode && current.algorithm == record.algorithm) {
+            target = slot;
+            break;
+        }
+        if (torn && target == header->slots) {
+            target = slot;
+        }
+    }
+    if (target != header->slots) {
+        records[target] = record;
+    }
+}
+
+// cached file digest
+void FileDigestCache::fileDigest(HashAlgorithm algorithm, const std::string& path, uint8_t* digest) {
+    size_t length = HashLite::digestSize(algorithm); // also rejects unsupported algorithms
+    struct stat before;
+    if (::stat(path.c_str(), &before) != 0) {
+        throw std::runtime_error("Unable to open file: " + path);
+    }
+    uint64_t device = static_cast<uint64_t>(before.st_dev);
+    uint64_t inode = static_cast<uint64_t>(before.st_ino);
+    uint64_t size = static_cast<uint64_t>(before.st_size);
+    int64_t mtime = modifiedNs(before);
+
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        if (S_ISREG(before.st_mode) && lookup(device, inode, size, mtime, algorithm, digest)) {
+            counters.hits += 1;
+            return;
+        }
+        counters.misses += 1;
+    }
+
+    HashLite(algorithm).computeFileDigest(path, digest);
+
+    // only cache a digest that belongs to one stable version of a regular file
+    struct stat after;
+    int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::system_clock::now().time_since_epoch()).count();
+    if (!S_ISREG(before.st_mode) || length > sizeof(CacheRecord::digest) || ::stat(path.c_str(), &after) != 0 ||
+        after.st_dev != before.st_dev || after.st_ino != before.st_ino || after.st_size != before.st_size ||
+        modifiedNs(after) != mtime || mtime > now - RacyWindow) {
+        return;
+    }
+
+    // without the file lock another process may be writing the table, so the digest stays uncached
+    std::lock_guard<std::mutex> guard(mutex);
+    FileLock lock(fd);
+    if (!lock.held() || !reopenIfReplaced()) {
+        return;
+    }
+    try {
+        store(device, inode, size, mtime, algorithm, digest, length);
+        counters.stores += 1;
+    } catch (const std::runtime_error&) {
+        // a full disk or failed remap only loses this record, the digest itself is valid
+    }
+}
+
+// drop records in place, the size stays so mappings in other processes stay valid
+void FileDigestCache::clear() {
+    std::lock_guard<std::mutex> guard(mutex);
+    FileLock lock(fd);
+    if (!lock.held() || !reopenIfReplaced()) {
+        throw std::runtime_error("Unable to lock digest cache: " + cachePath);
+    }
+    CacheHeader* header = reinterpret_cast<CacheHeader*>(mapping);
+    header->used = 0;
+    std::memset(mapping + sizeof(CacheHeader), 0, mappingSize - sizeof(CacheHeader));
+}
+
+// record count
+size_t FileDigestCache::size() const {
+    std::lock_guard<std::mutex> guard(mutex);
+    return static_cast<size_t>(reinterpret_cast<const CacheHeader*>(mapping)->used);
+}
+#else
+// cache constructor, nothing is persisted on this platform
+FileDigestCache::FileDigestCache(const std::string& path) : cachePath(path), fd(-1), mapping(nullptr), mappingSize(0) {}
+
+// cache destructor
+FileDigestCache::~FileDigestCache() {}
+
+// hash file
+void FileDigestCache::fileDigest(HashAlgorithm algorithm, const std::string& path, uint8_t* digest) {
+    HashLite(algorithm).computeFileDigest(path, digest);
+    std::lock_guard<std::mutex> guard(mutex);
+    counters.misses += 1;
+}
+
+// nothing to drop
+void FileDigestCache::clear() {}
+
+// no records
+size_t FileDigestCache::size() const {
+    return 0;
+}
+#endif
+
+// counters
+FileDigestCacheStats FileDigestCache::stats() const {
+    std::lock_guard<std::mutex> guard(mutex);
+    return counters;
+}
@@ -0,0 +1,46 @@
+#include "HKDF.h"
+#include "HMAC.h"
+#include <algorithm>
+#include <stdexcept> // Error handling
+
+// extract step, PRK = HMAC(salt, IKM)
+void HKDF::extract(HashAlgorithm algorithm, const uint8_t* salt, size_t saltLength,
+                   const uint8_t* ikm, size_t ikmLength, uint8_t* prk) {
+    // an absent salt is a string of zeros, which HMAC pads to the same key
+    HMAC mac(algorithm, salt, saltLength);
+    mac.compute(ikm, ikmLength, prk);
+}
+
+// expand step, T(i) = HMAC(PRK, T(i-1) || info || i)
+void HKDF::expand(HashAlgorithm algorithm, const uint8_t* prk, size_t prkLength,
+                  const uint8_t* info, size_t infoLength, uint8_t* output, size_t outputLength) {
+    HMAC mac(algorithm, prk, prkLength);
+    size_t size = mac.digestSize();
+    if (outputLength > 255 * size) {
+        throw std::runtime_error("HKDF output too long");
+    }
+
+    std::vector<uint8_t> message;
+    uint8_t block[64];
+    for (size_t offset = 0, counter = 1; offset < outputLength; offset += size, ++counter) {
+        message.assign(block, block + (counter == 1 ? 0 : size));
+        message.insert(message.end(), info, info + infoLength);
+        message.push_back(static_cast<uint8_t>(counter));
+
+        mac.compute(message.data(), message.size(), block);
+        std::copy(block, block + std::min(size, outputLength - offset), output + offset);
+    }
+}
+
+// extract then expand
+std::vector<uint8_t> HKDF::derive(HashAlgorithm algorithm, const std::string& ikm, const std::string& salt,
+                                  const std::string& info, size_t outputLength) {
+    uint8_t prk[64];
+    extract(algorithm, reinterpret_cast<const uint8_t*>(salt.data()), salt.size(),
+            reinterpret_cast<const uint8_t*>(ikm.data()), ikm.size(), prk);
+
+    std::vector<uint8_t> output(outputLength);
+    expand(algorithm, prk, HashLite::digestSize(algorithm),
+           reinterpret_cast<const uint8_t*>(info.data()), info.size(), output.data(), outputLength);
+    return output;
+}
@@ -0,0 +1,123 @@
+#include "HMAC.h"
+#include <stdexcept> // Error handling
+#include <vector>
+
+// block size based on algorithm
+size_t HMAC::blockSize(HashAlgorithm algorithm) {
+    switch (algorithm) {
+        case HashAlgorithm::SHA1:
+        case HashAlgorithm::SHA224:
+        case HashAlgorithm::SHA256:
+        case HashAlgorithm::MD5:
+            return 64;
+        case HashAlgorithm::SHA384:
+        case HashAlgorithm::SHA512:
+        case HashAlgorithm::SHA512_256:
+        case HashAlgorithm::SHA512_224:
+            return 128;
+        // SHA-3 blocks are the sponge rate
+        case HashAlgorithm::SHA3_224:
+            return 144;
+        case HashAlgorithm::SHA3_256:
+            return 136;
+        case HashAlgorithm::SHA3_384:
+            return 104;
+        case HashAlgorithm::SHA3_512:
+            return 72;
+        default:
+            throw std::runtime_error("Unsupported algorithm for HMAC"); // checksums have no keyed mode
+    }
+}
+
+// hmac constructor
+HMAC::HMAC(HashAlgorithm algorithm, const std::string& key)
+    : HMAC(algorithm, reinterpret_cast<const uint8_t*>(key.data()), key.size()) {}
+
+// hmac constructor with raw key
+HMAC::HMAC(HashAlgorithm algorithm, const uint8_t* key, size_t keyLength) : inner(algorithm), outer(algorithm) {
+    size_t block = blockSize(algorithm);
+    std::vector<uint8_t> pad(block, 0);
+
+    // keys longer than a block are hashed first
+    if (keyLength > block) {
+        inner.update(key, keyLength);
+        inner.final(pad.data());
+    } else if (keyLength > 0) {
+        std::copy(key, key + keyLength, pad.begin());
+    }
+
+    // absorb key ^ ipad and key ^ opad once
+    for (uint8_t& byte : pad) {
+        byte ^= 0x36;
+    }
+    inner.update(pad.data(), block);
+    for (uint8_t& byte : pad) {
+        byte ^= 0x36 ^ 0x5c;
+    }
+    outer.update(pad.data(), block);
+
+    // clear key material
+    std::fill(pad.begin(), pad.end(), 0);
+}
+
+// tag size
+size_t HMAC::digestSize() const {
+    return inner.digestSize();
+}
+
+// finish tag
+void HMAC::finish(HashContext& message, uint8_t* tag) const {
+    uint8_t innerDigest[64];
+    message.final(innerDigest);
+
+    HashContext result = outer; // copy cached outer state
+    result.update(innerDigest, digestSize());
+    result.final(tag);
+}
+
+// compute tag of raw bytes
+void HMAC::compute(const uint8_t* data, size_t length, uint8_t* tag) const {
+    HashContext message = inner; // copy cached inner state
+    message.update(data, length);
+    finish(message, tag);
+}
+
+// compute tag as hex
+std::string HMAC::compute(const std::string& message) const {
+    uint8_t tag[64];
+    compute(reinterpret_cast<const uint8_t*>(message.data()), message.size(), tag);
+
+    // format tag as hex
+    static const char digits[] = "0123456789abcdef";
+    std::string result;
+    for (size_t i = 0; i < digestSize(); ++i) {
+        result += digits[tag[i] >> 4];
+        result += digits[tag[i] & 0x0F];
+    }
+    return result;
+}
+
+// verify tag of raw bytes
+bool HMAC::verify(const uint8_t* data, size_t length, const uint8_t* expected, size_t expectedLength) const {
+    if (expectedLength != digestSize()) {
+        return false; // tag length is public
+    }
+    uint8_t tag[64];
+    compute(data, length, tag);
+    return constantTimeEqual(tag, expected, expectedLength);
+}
+
+// verify tag of string
+bool HMAC::verify(const std::string& message, const std::string& expected) const {
+    return verify(reinterpret_cast<const uint8_t*>(message.data()), message.size(),
+                  reinterpret_cast<const uint8_t*>(expected.data()), expected.size());
+}
+
+// constant time compare
+bool HMAC::constantTimeEqual(const uint8_t* a, const uint8_t* b, size_t length) {
+    volatile uint8_t difference = 0;
+    for (size_t i = 0; i < length; ++i) {
+        difference |= a[i] ^ b[i];
+    }
+    return difference == 0;
+}
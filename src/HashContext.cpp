@@ -0,0 +1,250 @@
+#include "HashContext.h"
+#include "HashState.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept> // Error handling
+#include <type_traits>
+
+// create algorithm state
+static std::variant<SHA256, MD5, CRC32, CRC8, CRC16, SHA1, SHA224, SHA384, SHA512, BLAKE3, XXH64, XXH3, XXH128, SHA3, SHAKE, SHA512_256, SHA512_224, CRC64> makeEngine(HashAlgorithm algorithm) {
+    switch (algorithm) {
+        case HashAlgorithm::SHA256: return SHA256();
+        case HashAlgorithm::MD5: return MD5();
+        case HashAlgorithm::CRC32: return CRC32();
+        case HashAlgorithm::CRC8: return CRC8();
+        case HashAlgorithm::CRC16: return CRC16();
+        case HashAlgorithm::SHA1: return SHA1();
+        case HashAlgorithm::SHA224: return SHA224();
+        case HashAlgorithm::SHA384: return SHA384();
+        case HashAlgorithm::SHA512: return SHA512();
+        case HashAlgorithm::BLAKE3: return BLAKE3();
+        case HashAlgorithm::XXH64: return XXH64();
+        case HashAlgorithm::XXH3: return XXH3();
+        case HashAlgorithm::XXH128: return XXH128();
+        case HashAlgorithm::SHA3_224: return SHA3(SHA3::OutputSize224);
+        case HashAlgorithm::SHA3_256: return SHA3(SHA3::OutputSize256);
+        case HashAlgorithm::SHA3_384: return SHA3(SHA3::OutputSize384);
+        case HashAlgorithm::SHA3_512: return SHA3(SHA3::OutputSize512);
+        case HashAlgorithm::SHAKE128: return SHAKE(128);
+        case HashAlgorithm::SHAKE256: return SHAKE(256);
+        case HashAlgorithm::SHA512_256: return SHA512_256();
+        case HashAlgorithm::SHA512_224: return SHA512_224();
+        case HashAlgorithm::CRC64: return CRC64(CRC64Variant::XZ);
+        case HashAlgorithm::CRC64_ECMA: return CRC64(CRC64Variant::ECMA);
+        case HashAlgorithm::CRC64_NVME: return CRC64(CRC64Variant::NVMe);
+        default:
+            throw std::runtime_error("Unsupported algorithm"); // error data for unsuported algorithm
+    }
+}
+
+// serialized record header and format version
+static const uint8_t StateMagic[4] = {'H', 'L', 'S', 'C'};
+static constexpr uint8_t StateVersion = 1;
+
+// stable record id of each algorithm, independent of the enum order
+static uint8_t stateId(HashAlgorithm algorithm) {
+    switch (algorithm) {
+        case HashAlgorithm::SHA256: return 1;
+        case HashAlgorithm::MD5: return 2;
+        case HashAlgorithm::CRC32: return 3;
+        case HashAlgorithm::CRC8: return 4;
+        case HashAlgorithm::CRC16: return 5;
+        case HashAlgorithm::SHA1: return 6;
+        case HashAlgorithm::SHA224: return 7;
+        case HashAlgorithm::SHA384: return 8;
+        case HashAlgorithm::SHA512: return 9;
+        case HashAlgorithm::BLAKE3: return 10;
+        case HashAlgorithm::XXH64: return 11;
+        case HashAlgorithm::XXH3: return 12;
+        case HashAlgorithm::XXH128: return 13;
+        case HashAlgorithm::SHA3_224: return 14;
+        case HashAlgorithm::SHA3_256: return 15;
+        case HashAlgorithm::SHA3_384: return 16;
+        case HashAlgorithm::SHA3_512: return 17;
+        case HashAlgorithm::SHAKE128: return 18;
+        case HashAlgorithm::SHAKE256: return 19;
+        case HashAlgorithm::SHA512_256: return 20;
+        case HashAlgorithm::SHA512_224: return 21;
+        case HashAlgorithm::CRC64: return 22;
+        case HashAlgorithm::CRC64_ECMA: return 23;
+        case HashAlgorithm::CRC64_NVME: return 24;
+        default:
+            throw std::runtime_error("Unsupported algorithm"); // error data for unsuported algorithm
+    }
+}
+
+// algorithm of a record id
+static HashAlgorithm stateAlgorithm(uint8_t id) {
+    for (HashAlgorithm algorithm : {HashAlgorithm::SHA256, HashAlgorithm::MD5, HashAlgorithm::CRC32,
+                                    HashAlgorithm::CRC8, HashAlgorithm::CRC16, HashAlgorithm::SHA1,
+                                    HashAlgorithm::SHA224, HashAlgorithm::SHA384, HashAlgorithm::SHA512,
+                                    HashAlgorithm::BLAKE3, HashAlgorithm::XXH64, HashAlgorithm::XXH3,
+                                    HashAlgorithm::XXH128, HashAlgorithm::SHA3_224, HashAlgorithm::SHA3_256,
+                                    HashAlgorithm::SHA3_384, HashAlgorithm::SHA3_512, HashAlgorithm::SHAKE128,
+                                    HashAlgorithm::SHAKE256, HashAlgorithm::SHA512_256, HashAlgorithm::SHA512_224,
+                                    HashAlgorithm::CRC64, HashAlgorithm::CRC64_ECMA, HashAlgorithm::CRC64_NVME}) {
+        if (stateId(algorithm) == id) {
+            return algorithm;
+        }
+    }
+    throw std::runtime_error("Unsupported algorithm in hash state");
+}
+
+// checksum of a record body
+static uint32_t stateChecksum(const uint8_t* data, size_t length) {
+    uint8_t digest[CRC32::OutputSize];
+    CRC32().hash(data, length, digest);
+    return (static_cast<uint32_t>(digest[0]) << 24) | (static_cast<uint32_t>(digest[1]) << 16) |
+           (static_cast<uint32_t>(digest[2]) << 8) | digest[3];
+}
+
+// context constructor
+HashContext::HashContext(HashAlgorithm algorithm) : selected(algorithm), engine(makeEngine(algorithm)) {}
+
+// feed data
+void HashContext::update(const std::string& data) {
+    update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+}
+
+// feed raw bytes
+void HashContext::update(const uint8_t* data, size_t length) {
+    std::visit([data, length](auto& hasher) { hasher.update(data, length); }, engine);
+}
+
+// feed segments, the algorithm buffer carries partial blocks across segment boundaries
+void HashContext::update(const HashInput* segments, size_t count) {
+    std::visit([segments, count](auto& hasher) {
+        for (size_t i = 0; i < count; ++i) {
+            hasher.update(segments[i].data, segments[i].length);
+        }
+    }, engine);
+}
+
+#ifndef _WIN32
+// feed iovec segments
+void HashContext::update(const struct iovec* segments, int count) {
+    std::visit([segments, count](auto& hasher) {
+        for (int i = 0; i < count; ++i) {
+            hasher.update(static_cast<const uint8_t*>(segments[i].iov_base), segments[i].iov_len);
+        }
+    }, engine);
+}
+#endif
+
+// engines that can skip over zero bytes
+template <typename Engine, typename = void>
+struct SkipsZeros : std::false_type {};
+
+template <typename Engine>
+struct SkipsZeros<Engine, std::void_t<decltype(std::declval<Engine&>().updateZeros(uint64_t()))>> : std::true_type {};
+
+// feed zero bytes, other engines hash them from a shared zero block
+void HashContext::updateZeros(uint64_t length) {
+    std::visit([length](auto& hasher) {
+        if constexpr (SkipsZeros<std::decay_t<decltype(hasher)>>::value) {
+            hasher.updateZeros(length);
+        } else {
+            static const std::vector<uint8_t> zeros(1 << 16);
+            for (uint64_t left = length; left > 0;) {
+                size_t take = static_cast<size_t>(std::min<uint64_t>(left, zeros.size()));
+                hasher.update(zeros.data(), take);
+                left -= take;
+            }
+        }
+    }, engine);
+}
+
+// finalize as string
+std::string HashContext::final() {
+    return std::visit([](auto& hasher) { return hasher.final(); }, engine);
+}
+
+// finalize as binary
+void HashContext::final(uint8_t* digest) {
+    std::visit([digest](auto& hasher) { hasher.final(digest); }, engine);
+}
+
+// reset state
+void HashContext::reset() {
+    std::visit([](auto& hasher) { hasher.reset(); }, engine);
+}
+
+// copy state
+HashContext HashContext::clone() const {
+    return *this;
+}
+
+// finalize prefix and suffix on a copy
+void HashContext::finalWith(const uint8_t* suffix, size_t length, uint8_t* digest) const {
+    HashContext message = *this;
+    message.update(suffix, length);
+    message.final(digest);
+}
+
+// finalize suffixes on shared pool
+void HashContext::finalBatch(const HashInput* suffixes, size_t count, uint8_t* digests) const {
+    finalBatch(suffixes, count, digests, ThreadPool::shared());
+}
+
+// finalize suffixes on given pool
+void HashContext::finalBatch(const HashInput* suffixes, size_t count, uint8_t* digests, ThreadPool& pool) const {
+    size_t size = digestSize();
+
+    pool.parallelFor(count, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            finalWith(suffixes[i].data, suffixes[i].length, digests + i * size);
+        }
+    });
+}
+
+// save state
+std::vector<uint8_t> HashContext::serialize() const {
+    std::vector<uint8_t> record;
+    HashStateWriter writer(record);
+    writer.putBytes(StateMagic, sizeof(StateMagic));
+    writer.putWord(StateVersion, 1);
+    writer.putWord(stateId(selected), 1);
+    std::visit([&writer](const auto& hasher) { hasher.saveState(writer); }, engine);
+    writer.putWord(stateChecksum(record.data(), record.size()), 4);
+    return record;
+}
+
+// restore state
+HashContext HashContext::deserialize(const uint8_t* data, size_t length) {
+    if (length < sizeof(StateMagic) + 6 || std::memcmp(data, StateMagic, sizeof(StateMagic)) != 0) {
+        throw std::runtime_error("Invalid hash state");
+    }
+
+    HashStateReader trailer(data + length - 4, 4);
+    if (trailer.getWord(4) != stateChecksum(data, length - 4)) {
+        throw std::runtime_error("Corrupt hash state");
+    }
+
+    HashStateReader reader(data + sizeof(StateMagic), length - sizeof(StateMagic) - 4);
+    if (reader.getWord(1) != StateVersion) {
+        throw std::runtime_error("Unsupported hash state version");
+    }
+
+    HashContext context(stateAlgorithm(static_cast<uint8_t>(reader.getWord(1))));
+    std::visit([&reader](auto& hasher) { hasher.loadState(reader); }, context.engine);
+    if (reader.remaining() != 0) {
+        throw std::runtime_error("Invalid hash state");
+    }
+    return context;
+}
+
+// restore state from vector
+HashContext HashContext::deserialize(const std::vector<uint8_t>& record) {
+    return deserialize(record.data(), record.size());
+}
+
+// selected algorithm
+HashAlgorithm HashContext::algorithm() const {
+    return selected;
+}
+
+// digest size
+size_t HashContext::digestSize() const {
+    return HashLite::digestSize(selected);
+}
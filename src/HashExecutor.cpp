@@ -0,0 +1,254 @@
+#include "HashExecutor.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <map>
+
+// token constructor
+CancellationToken::CancellationToken() : flag(std::make_shared<std::atomic<bool>>(false)) {}
+
+// request cancellation
+void CancellationToken::cancel() {
+    flag->store(true);
+}
+
+// check cancellation
+bool CancellationToken::cancelled() const {
+    return flag->load();
+}
+
+// executor constructor
+HashExecutor::HashExecutor(ThreadPool& pool, const HashExecutorOptions& options)
+    : pool(pool), options(options), tokens(0) {
+    if (this->options.chunkSize == 0) {
+        this->options.chunkSize = 1; // bulk jobs must make progress
+    }
+}
+
+// executor on shared pool
+HashExecutor::HashExecutor() : HashExecutor(ThreadPool::shared()) {}
+
+// executor destructor
+HashExecutor::~HashExecutor() {
+    // every queued request holds a pool task, so no tasks means no requests
+    std::unique_lock<std::mutex> lock(tokenMutex);
+    idle.wait(lock, [this] { return tokens == 0; });
+}
+
+// shared executor
+HashExecutor& HashExecutor::shared() {
+    static HashExecutor executor;
+    return executor;
+}
+
+// queue in memory request
+std::future<std::vector<uint8_t>> HashExecutor::hashAsync(HashAlgorithm algorithm, std::string input,
+                                                           HashCallback onComplete, CancellationToken token,
+                                                           HashPriority priority) {
+    HashLite::digestSize(algorithm); // reject unsupported algorithms on the calling thread
+
+    auto request = std::make_shared<Request>();
+    request->algorithm = algorithm;
+    request->input = std::move(input);
+    request->callback = std::move(onComplete);
+    request->token = std::move(token);
+    std::future<std::vector<uint8_t>> result = request->promise.get_future();
+
+    bool urgent = priority == HashPriority::Latency ||
+                  (priority == HashPriority::Auto && request->input.size() < options.batchThreshold);
+    enqueue(request, urgent);
+    return result;
+}
+
+// queue streamed request
+std::future<std::vector<uint8_t>> HashExecutor::hashAsync(HashAlgorithm algorithm, HashSource source,
+                                                           HashCallback onComplete, CancellationToken token) {
+    HashLite::digestSize(algorithm); // reject unsupported algorithms on the calling thread
+
+    auto request = std::make_shared<Request>();
+    request->algorithm = algorithm;
+    request->source = std::move(source);
+    request->callback = std::move(onComplete);
+    request->token = std::move(token);
+    std::future<std::vector<uint8_t>> result = request->promise.get_future();
+
+    enqueue(request, false);
+    return result;
+}
+
+// metrics snapshot
+HashExecutorStats HashExecutor::stats() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    HashExecutorStats snapshot = metrics;
+    snapshot.priority.queueDepth = priorityLane.size();
+    snapshot.bulk.queueDepth = bulkLane.size();
+    return snapshot;
+}
+
+// queue request
+void HashExecutor::enqueue(const std::shared_ptr<Request>& request, bool urgent) {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        request->queued = std::chrono::steady_clock::now();
+        if (urgent) {
+            priorityLane.push_back(request);
+        } else {
+            bulkLane.push_back(request);
+        }
+    }
+    schedule();
+}
+
+// submit pool task
+void HashExecutor::schedule() {
+    {
+        std::lock_guard<std::mutex> lock(tokenMutex);
+        ++tokens;
+    }
+    pool.submit([this] { runNext(); });
+}
+
+// record time a request spent queued
+static void recordWait(HashLaneStats& lane, std::chrono::steady_clock::time_point queued,
+                       std::chrono::steady_clock::time_point now) {
+    auto wait = std::chrono::duration_cast<std::chrono::nanoseconds>(now - queued);
+    lane.started += 1;
+    lane.totalWait += wait;
+    if (wait > lane.maxWait) {
+        lane.maxWait = wait;
+    }
+}
+
+// run next unit of work, priority lane first
+void HashExecutor::runNext() {
+    std::vector<std::shared_ptr<Request>> urgent;
+    std::shared_ptr<Request> job;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        auto now = std::chrono::steady_clock::now();
+        if (!priorityLane.empty()) {
+            // take everything waiting, up to one batch
+            while (!priorityLane.empty() && urgent.size() < options.maxBatch) {
+                recordWait(metrics.priority, priorityLane.front()->queued, now);
+                urgent.push_back(std::move(priorityLane.front()));
+                priorityLane.pop_front();
+            }
+        } else if (!bulkLane.empty()) {
+            job = std::move(bulkLane.front());
+            bulkLane.pop_front();
+            if (!job->started) {
+                job->started = true;
+                recordWait(metrics.bulk, job->queued, now);
+            }
+        }
+    }
+
+    if (!urgent.empty()) {
+        runBatch(urgent);
+    } else if (job && !runChunk(*job)) {
+        // unfinished job goes behind other bulk jobs
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            bulkLane.push_back(std::move(job));
+        }
+        schedule();
+    }
+
+    // last access to this, the destructor may return right after
+    std::lock_guard<std::mutex> lock(tokenMutex);
+    if (--tokens == 0) {
+        idle.notify_all();
+    }
+}
+
+// hash batch of small requests
+void HashExecutor::runBatch(std::vector<std::shared_ptr<Request>>& requests) {
+    // group live requests by algorithm so each group runs as one batch
+    std::map<HashAlgorithm, std::vector<std::shared_ptr<Request>>> groups;
+    for (auto& request : requests) {
+        if (request->token.cancelled()) {
+            complete(*request, std::make_exception_ptr(HashCancelled()), {});
+        } else {
+            groups[request->algorithm].push_back(request);
+        }
+    }
+
+    for (auto& group : groups) {
+        HashLite hasher(group.first);
+        size_t size = hasher.digestSize();
+        std::vector<HashInput> inputs(group.second.size());
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            const std::string& input = group.second[i]->input;
+            inputs[i] = {reinterpret_cast<const uint8_t*>(input.data()), input.size()};
+        }
+
+        std::vector<uint8_t> digests(inputs.size() * size);
+        try {
+            hasher.computeBatch(inputs.data(), inputs.size(), digests.data(), pool);
+        } catch (...) {
+            for (auto& request : group.second) {
+                complete(*request, std::current_exception(), {});
+            }
+            continue;
+        }
+
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            std::vector<uint8_t> digest(digests.begin() + i * size, digests.begin() + (i + 1) * size);
+            complete(*group.second[i], nullptr, digest);
+        }
+    }
+}
+
+// hash one chunk of a bulk job
+bool HashExecutor::runChunk(Request& job) {
+    if (job.token.cancelled()) {
+        complete(job, std::make_exception_ptr(HashCancelled()), {});
+        return true;
+    }
+
+    try {
+        if (!job.context) {
+            job.context.emplace(job.algorithm);
+        }
+
+        if (job.source) {
+            // read next chunk, an empty read ends the input
+            job.chunk.resize(options.chunkSize);
+            size_t read = job.source(job.chunk.data(), job.chunk.size());
+            if (read > 0) {
+                job.context->update(job.chunk.data(), std::min(read, job.chunk.size()));
+                return false;
+            }
+        } else if (job.offset < job.input.size()) {
+            size_t take = std::min(options.chunkSize, job.input.size() - job.offset);
+            job.context->update(reinterpret_cast<const uint8_t*>(job.input.data()) + job.offset, take);
+            job.offset += take;
+            if (job.offset < job.input.size()) {
+                return false;
+            }
+        }
+
+        std::vector<uint8_t> digest(job.context->digestSize());
+        job.context->final(digest.data());
+        complete(job, nullptr, digest);
+    } catch (...) {
+        complete(job, std::current_exception(), {});
+    }
+    return true;
+}
+
+// finish request
+void HashExecutor::complete(Request& request, std::exception_ptr error, const std::vector<uint8_t>& digest) {
+    if (request.callback) {
+        request.callback(error, digest);
+    }
+
+    if (error) {
+        request.promise.set_exception(error);
+    } else {
+        request.promise.set_value(digest);
+    }
+
+    // release input memory early, the request may stay referenced until its task ends
+    std::string().swap(request.input);
+    std::vector<uint8_t>().swap(request.chunk);
+}
@@ -4,11 +4,36 @@
 #include "CRC32.h" // CRC32 Header
 #include "CRC8.h" // CRC8 header
 #include "CRC16.h" // CRC16 header
+#include "CRC64.h" // CRC64 header
 #include "SHA1.h" // SHA1 header
 #include "SHA224.h" // SHA224 Header
 #include "SHA384.h" // SHA384 header
 #include "SHA512.h" // SHA512 Header
+#include "SHA512_256.h" // SHA512/256 header
+#include "SHA512_224.h" // SHA512/224 header
+#include "BLAKE3.h" // BLAKE3 header
+#include "XXH64.h" // XXH64 header
+#include "XXH3.h" // XXH3 header
+#include "XXH128.h" // XXH128 header
+#include "SHA3.h" // SHA3 header
+#include "SHAKE.h" // SHAKE header
+#include "ThreadPool.h" // batch worker pool
+#include "HashContext.h" // streaming state
+#include "HMAC.h" // constant time compare
+#include "FileDigestCache.h" // cached file digests
 #include <stdexcept> // Error handling
+#include <fstream> // file hashing
+#include <algorithm>
+#include <bitset>
+#include <limits>
+#include <vector>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h> // sparse file hashing
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 // hashlite constructor
 HashLite::HashLite(HashAlgorithm algorithm) : algorithm(algorithm) {}
@@ -36,6 +61,42 @@ std::string HashLite::computeHash(const std::string& input) {
             SHA512 sha512; // create object
             return SHA512::hash(input); // return hash
         }
+        case HashAlgorithm::BLAKE3: { // define algorithm
+            return BLAKE3::hash(input); // return hash
+        }
+        case HashAlgorithm::XXH64: { // define algorithm
+            return XXH64::hash(input); // return hash
+        }
+        case HashAlgorithm::XXH3: { // define algorithm
+            return XXH3::hash(input); // return hash
+        }
+        case HashAlgorithm::XXH128: { // define algorithm
+            return XXH128::hash(input); // return hash
+        }
+        case HashAlgorithm::SHA3_224: { // define algorithm
+            return SHA3::hash(input, SHA3::OutputSize224); // return hash
+        }
+        case HashAlgorithm::SHA3_256: { // define algorithm
+            return SHA3::hash(input, SHA3::OutputSize256); // return hash
+        }
+        case HashAlgorithm::SHA3_384: { // define algorithm
+            return SHA3::hash(input, SHA3::OutputSize384); // return hash
+        }
+        case HashAlgorithm::SHA3_512: { // define algorithm
+            return SHA3::hash(input, SHA3::OutputSize512); // return hash
+        }
+        case HashAlgorithm::SHAKE128: { // define algorithm
+            return SHAKE::hash(input, 128); // return hash
+        }
+        case HashAlgorithm::SHAKE256: { // define algorithm
+            return SHAKE::hash(input, 256); // return hash
+        }
+        case HashAlgorithm::SHA512_256: { // define algorithm
+            return SHA512_256::hash(input); // return hash
+        }
+        case HashAlgorithm::SHA512_224: { // define algorithm
+            return SHA512_224::hash(input); // return hash
+        }
         case HashAlgorithm::MD5: { // define algorithm
             MD5 md5; // create object
             return MD5::hash(input); // return hash
@@ -52,8 +113,435 @@ std::string HashLite::computeHash(const std::string& input) {
             CRC16 crc16; // create object
             return crc16.hash(input); // return hash
         }         
+        case HashAlgorithm::CRC64: { // define algorithm
+            CRC64 crc64(CRC64Variant::XZ); // create object
+            return crc64.hash(input); // return hash
+        }
+        case HashAlgorithm::CRC64_ECMA: { // define algorithm
+            CRC64 crc64(CRC64Variant::ECMA); // create object
+            return crc64.hash(input); // return hash
+        }
+        case HashAlgorithm::CRC64_NVME: { // define algorithm
+            CRC64 crc64(CRC64Variant::NVMe); // create object
+            return crc64.hash(input); // return hash
+        }
+
+        default:
+            throw std::runtime_error("Unsupported algorithm"); // error data for unsuported algorithm
+    }
+}
+
+// digest size based on algorithm
+size_t HashLite::digestSize(HashAlgorithm algorithm) {
+    switch (algorithm) {
+        case HashAlgorithm::SHA256: return SHA256::OutputSize;
+        case HashAlgorithm::SHA1: return SHA1::OutputSize;
+        case HashAlgorithm::SHA224: return SHA224::OutputSize;
+        case HashAlgorithm::SHA384: return SHA384::OutputSize;
+        case HashAlgorithm::SHA512: return SHA512::OutputSize;
+        case HashAlgorithm::SHA512_256: return SHA512_256::OutputSize;
+        case HashAlgorithm::SHA512_224: return SHA512_224::OutputSize;
+        case HashAlgorithm::BLAKE3: return BLAKE3::OutputSize;
+        case HashAlgorithm::XXH64: return XXH64::OutputSize;
+        case HashAlgorithm::XXH3: return XXH3::OutputSize;
+        case HashAlgorithm::XXH128: return XXH128::OutputSize;
+        case HashAlgorithm::SHA3_224: return SHA3::OutputSize224;
+        case HashAlgorithm::SHA3_256: return SHA3::OutputSize256;
+        case HashAlgorithm::SHA3_384: return SHA3::OutputSize384;
+        case HashAlgorithm::SHA3_512: return SHA3::OutputSize512;
+        case HashAlgorithm::SHAKE128: return SHAKE::OutputSize128;
+        case HashAlgorithm::SHAKE256: return SHAKE::OutputSize256;
+        case HashAlgorithm::MD5: return MD5::OutputSize;
+        case HashAlgorithm::CRC32: return CRC32::OutputSize;
+        case HashAlgorithm::CRC8: return CRC8::OutputSize;
+        case HashAlgorithm::CRC16: return CRC16::OutputSize;
+        case HashAlgorithm::CRC64:
+        case HashAlgorithm::CRC64_ECMA:
+        case HashAlgorithm::CRC64_NVME: return CRC64::OutputSize;
+        default:
+            throw std::runtime_error("Unsupported algorithm"); // error data for unsuported algorithm
+    }
+}
+
+// digest size of selected algorithm
+size_t HashLite::digestSize() const {
+    return digestSize(algorithm);
+}
+
+// CRC-64 variant of an algorithm
+static CRC64Variant crc64Variant(HashAlgorithm algorithm) {
+    switch (algorithm) {
+        case HashAlgorithm::CRC64_ECMA: return CRC64Variant::ECMA;
+        case HashAlgorithm::CRC64_NVME: return CRC64Variant::NVMe;
+        default: return CRC64Variant::XZ;
+    }
+}
+
+// hash a range of inputs, one hasher object per range
+static void digestRange(HashAlgorithm algorithm, const HashInput* inputs, size_t count, uint8_t* digests) {
+    size_t size = HashLite::digestSize(algorithm);
 
+    switch (algorithm) {
+        case HashAlgorithm::SHA256: {
+            for (size_t i = 0; i < count; ++i) {
+                SHA256::hash(inputs[i].data, inputs[i].length, digests + i * size);
+            }
+            break;
+        }
+        case HashAlgorithm::SHA1: {
+            SHA1 sha1; // create object, final() resets it for the next input
+            for (size_t i = 0; i < count; ++i) {
+                sha1.update(inputs[i].data, inputs[i].length);
+                sha1.final(digests + i * size);
+            }
+            break;
+        }
+        case HashAlgorithm::SHA224: {
+            SHA224 sha224; // create object, final() resets it for the next input
+            for (size_t i = 0; i < count; ++i) {
+                sha224.update(inputs[i].data, inputs[i].length);
+                sha224.final(digests + i * size);
+            }
+            break;
+        }
+        case HashAlgorithm::SHA384: {
+            for (size_t i = 0; i < count; ++i) {
+                SHA384::hash(inputs[i].data, inputs[i].length, digests + i * size);
+            }
+            break;
+        }
+        case HashAlgorithm::SHA512: {
+            for (size_t i = 0; i < count; ++i) {
+                SHA512::hash(inputs[i].data, inputs[i].length, digests + i * size);
+            }
+            break;
+        }
+        case HashAlgorithm::SHA512_256: {
+            for (size_t i = 0; i < count; ++i) {
+                SHA512_256::hash(inputs[i].data, inputs[i].length, digests + i * size);
+            }
+            break;
+        }
+        case HashAlgorithm::SHA512_224: {
+            for (size_t i = 0; i < count; ++i) {
+                SHA512_224::hash(inputs[i].data, inputs[i].length, digests + i * size);
+            }
+            break;
+        }
+        case HashAlgorithm::BLAKE3: {
+            for (size_t i = 0; i < count; ++i) {
+                BLAKE3::hash(inputs[i].data, inputs[i].length, digests + i * size);
+            }
+            break;
+        }
+        case HashAlgorithm::XXH64: {
+            for (size_t i = 0; i < count; ++i) {
+                XXH64::hash(inputs[i].data, inputs[i].length, digests + i * size);
+            }
+            break;
+        }
+        case HashAlgorithm::XXH3: {
+            for (size_t i = 0; i < count; ++i) {
+                XXH3::hash(inputs[i].data, inputs[i].length, digests + i * size);
+            }
+            break;
+        }
+        case HashAlgorithm::XXH128: {
+            for (size_t i = 0; i < count; ++i) {
+                XXH128::hash(inputs[i].data, inputs[i].length, digests + i * size);
+            }
+            break;
+        }
+        case HashAlgorithm::SHA3_224:
+        case HashAlgorithm::SHA3_256:
+        case HashAlgorithm::SHA3_384:
+        case HashAlgorithm::SHA3_512: {
+            SHA3 sha3(size); // create object, final() resets it for the next input
+            for (size_t i = 0; i < count; ++i) {
+                sha3.update(inputs[i].data, inputs[i].length);
+                sha3.final(digests + i * size);
+            }
+            break;
+        }
+        case HashAlgorithm::SHAKE128:
+        case HashAlgorithm::SHAKE256: {
+            SHAKE shake(size * 4); // create object, final() resets it for the next input
+            for (size_t i = 0; i < count; ++i) {
+                shake.update(inputs[i].data, inputs[i].length);
+                shake.final(digests + i * size);
+            }
+            break;
+        }
+        case HashAlgorithm::MD5: {
+            for (size_t i = 0; i < count; ++i) {
+                MD5::hash(inputs[i].data, inputs[i].length, digests + i * size);
+            }
+            break;
+        }
+        case HashAlgorithm::CRC32: {
+            CRC32 crc32; // create object, table built once per range
+            for (size_t i = 0; i < count; ++i) {
+                crc32.hash(inputs[i].data, inputs[i].length, digests + i * size);
+            }
+            break;
+        }
+        case HashAlgorithm::CRC8: {
+            CRC8 crc8; // create object
+            for (size_t i = 0; i < count; ++i) {
+                crc8.hash(inputs[i].data, inputs[i].length, digests + i * size);
+            }
+            break;
+        }
+        case HashAlgorithm::CRC16: {
+            CRC16 crc16; // create object
+            for (size_t i = 0; i < count; ++i) {
+                crc16.hash(inputs[i].data, inputs[i].length, digests + i * size);
+            }
+            break;
+        }
+        case HashAlgorithm::CRC64:
+        case HashAlgorithm::CRC64_ECMA:
+        case HashAlgorithm::CRC64_NVME: {
+            CRC64 crc64(crc64Variant(algorithm)); // create object, final() resets it for the next input
+            for (size_t i = 0; i < count; ++i) {
+                crc64.update(inputs[i].data, inputs[i].length);
+                crc64.final(digests + i * size);
+            }
+            break;
+        }
         default:
             throw std::runtime_error("Unsupported algorithm"); // error data for unsuported algorithm
     }
 }
+
+// compute binary hash
+void HashLite::computeDigest(const uint8_t* data, size_t length, uint8_t* digest) const {
+    HashInput input = {data, length};
+    digestRange(algorithm, &input, 1, digest);
+}
+
+// compute binary hash of segments
+void HashLite::computeDigest(const HashInput* segments, size_t count, uint8_t* digest) const {
+    HashContext context(algorithm);
+    context.update(segments, count);
+    context.final(digest);
+}
+
+// batch hash on shared pool
+void HashLite::computeBatch(const HashInput* inputs, size_t count, uint8_t* digests) const {
+    computeBatch(inputs, count, digests, ThreadPool::shared());
+}
+
+// batch hash on given pool
+void HashLite::computeBatch(const HashInput* inputs, size_t count, uint8_t* digests, ThreadPool& pool) const {
+    size_t size = digestSize(algorithm); // also rejects unsupported algorithms before queuing work
+    HashAlgorithm selected = algorithm;
+
+    pool.parallelFor(count, [=](size_t begin, size_t end) {
+        digestRange(selected, inputs + begin, end - begin, digests + begin * size);
+    });
+}
+
+// batch hash strings
+void HashLite::computeBatch(const std::vector<std::string>& inputs, uint8_t* digests) const {
+    std::vector<HashInput> views(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        views[i] = {reinterpret_cast<const uint8_t*>(inputs[i].data()), inputs[i].size()};
+    }
+    computeBatch(views.data(), views.size(), digests);
+}
+
+// inputs verified per failure bitmap word
+static constexpr size_t VerifyWord = 64;
+
+// pack one failure flag per input into the bitmap, returns the number of failures
+static size_t packFailures(const std::vector<uint8_t>& failed, uint64_t* failures) {
+    size_t count = failed.size();
+    for (size_t w = 0; w < (count + VerifyWord - 1) / VerifyWord; ++w) {
+        uint64_t bits = 0;
+        for (size_t i = w * VerifyWord; i < std::min(count, (w + 1) * VerifyWord); ++i) {
+            bits |= static_cast<uint64_t>(failed[i]) << (i % VerifyWord);
+        }
+        failures[w] = bits;
+    }
+
+    size_t total = 0;
+    for (size_t w = 0; w < (count + VerifyWord - 1) / VerifyWord; ++w) {
+        total += std::bitset<64>(failures[w]).count();
+    }
+    return total;
+}
+
+// batch verify on shared pool
+size_t HashLite::verifyBatch(const HashInput* inputs, const uint8_t* expected, size_t count, uint64_t* failures) const {
+    return verifyBatch(inputs, expected, count, failures, ThreadPool::shared());
+}
+
+// batch verify on given pool
+size_t HashLite::verifyBatch(const HashInput* inputs, const uint8_t* expected, size_t count, uint64_t* failures,
+                             ThreadPool& pool) const {
+    size_t size = digestSize(algorithm); // also rejects unsupported algorithms before queuing work
+    HashAlgorithm selected = algorithm;
+
+    // workers write one flag byte per input so ranges of any size can run in parallel, words are packed after
+    std::vector<uint8_t> failed(count);
+    pool.parallelFor(count, [=, &failed](size_t begin, size_t end) {
+        std::vector<uint8_t> digests(std::min(VerifyWord, end - begin) * size);
+        for (size_t first = begin; first < end; first += VerifyWord) {
+            size_t n = std::min(VerifyWord, end - first);
+            digestRange(selected, inputs + first, n, digests.data());
+            for (size_t i = 0; i < n; ++i) {
+                bool match = HMAC::constantTimeEqual(digests.data() + i * size, expected + (first + i) * size, size);
+                failed[first + i] = !match;
+            }
+        }
+    });
+    return packFailures(failed, failures);
+}
+
+#if !defined(_WIN32) && defined(SEEK_DATA) && defined(SEEK_HOLE)
+// closes descriptor on scope exit
+struct FileDescriptor {
+    int fd;
+    ~FileDescriptor() {
+        ::close(fd);
+    }
+};
+
+// feed bytes [offset, end) of a file in chunks, returns where reading stopped
+static off_t hashRange(int fd, bool seekable, off_t offset, off_t end, std::vector<uint8_t>& chunk,
+                       HashContext& context, const std::string& path) {
+    while (offset < end) {
+        size_t want = static_cast<size_t>(std::min<off_t>(end - offset, static_cast<off_t>(chunk.size())));
+        ssize_t count = seekable ? ::pread(fd, chunk.data(), want, offset) : ::read(fd, chunk.data(), want);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Unable to read file: " + path);
+        }
+        if (count == 0) {
+            break; // end of file
+        }
+        context.update(chunk.data(), static_cast<size_t>(count));
+        offset += count;
+    }
+    return offset;
+}
+
+// feed a file into a context in chunks, holes of sparse files are fed as zero runs without reading them
+static void hashFile(const std::string& path, HashContext& context) {
+    FileDescriptor file{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (file.fd < 0) {
+        throw std::runtime_error("Unable to open file: " + path);
+    }
+
+    std::vector<uint8_t> chunk(1 << 20); // large enough for BLAKE3 to hash subtrees in parallel
+    const off_t unbounded = std::numeric_limits<off_t>::max();
+
+    struct stat info;
+    if (::fstat(file.fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        hashRange(file.fd, false, 0, unbounded, chunk, context, path); // pipes and devices
+        return;
+    }
+
+    // alternate data and hole extents up to the size seen at open
+    off_t offset = 0;
+    while (offset < info.st_size) {
+        off_t data = ::lseek(file.fd, offset, SEEK_DATA);
+        if (data < 0) {
+            data = errno == ENXIO ? info.st_size : offset; // only a hole left, or no hole support
+        }
+        data = std::min(data, info.st_size);
+        context.updateZeros(static_cast<uint64_t>(data - offset));
+        offset = data;
+        if (offset >= info.st_size) {
+            break;
+        }
+
+        off_t hole = ::lseek(file.fd, offset, SEEK_HOLE);
+        if (hole < 0 || hole <= offset) {
+            hole = info.st_size;
+        }
+        off_t reached = hashRange(file.fd, true, offset, std::min(hole, info.st_size), chunk, context, path);
+        if (reached < std::min(hole, info.st_size)) {
+            return; // file shrank while hashing
+        }
+        offset = reached;
+    }
+
+    // bytes appended while hashing
+    hashRange(file.fd, true, offset, unbounded, chunk, context, path);
+}
+#else
+// feed a file into a context in chunks
+static void hashFile(const std::string& path, HashContext& context) {
+    std::ifstream file(path, std::ios::binary); // open file as binary
+    if (!file) {
+        throw std::runtime_error("Unable to open file: " + path);
+    }
+
+    std::vector<char> chunk(1 << 20); // large enough for BLAKE3 to hash subtrees in parallel
+    while (file) {
+        file.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        std::streamsize count = file.gcount();
+        if (count > 0) {
+            context.update(reinterpret_cast<const uint8_t*>(chunk.data()), static_cast<size_t>(count));
+        }
+    }
+    if (file.bad()) {
+        throw std::runtime_error("Unable to read file: " + path);
+    }
+}
+#endif
+
+// hash file
+std::string HashLite::computeFileHash(const std::string& path) const {
+    HashContext context(algorithm);
+    hashFile(path, context);
+    return context.final();
+}
+
+// hash file as binary
+void HashLite::computeFileDigest(const std::string& path, uint8_t* digest) const {
+    HashContext context(algorithm);
+    hashFile(path, context);
+    context.final(digest);
+}
+
+// hash file through cache
+void HashLite::computeFileDigest(const std::string& path, uint8_t* digest, FileDigestCache& cache) const {
+    cache.fileDigest(algorithm, path, digest);
+}
+
+// verify files on shared pool
+size_t HashLite::verifyFiles(const std::vector<std::string>& paths, const uint8_t* expected, uint64_t* failures) const {
+    return verifyFiles(paths, expected, failures, ThreadPool::shared());
+}
+
+// verify files on given pool
+size_t HashLite::verifyFiles(const std::vector<std::string>& paths, const uint8_t* expected, uint64_t* failures,
+                             ThreadPool& pool) const {
+    size_t size = digestSize(algorithm);
+    HashAlgorithm selected = algorithm;
+    size_t count = paths.size();
+
+    // one flag byte per file, words are packed after
+    std::vector<uint8_t> failed(count);
+    pool.parallelFor(count, [=, &paths, &failed](size_t begin, size_t end) {
+        std::vector<uint8_t> digest(size);
+        for (size_t i = begin; i < end; ++i) {
+            bool match = false;
+            try {
+                HashContext context(selected);
+                hashFile(paths[i], context);
+                context.final(digest.data());
+                match = HMAC::constantTimeEqual(digest.data(), expected + i * size, size);
+            } catch (const std::runtime_error&) {
+                match = false; // missing or unreadable file
+            }
+            failed[i] = !match;
+        }
+    });
+    return packFailures(failed, failures);
+}
@@ -0,0 +1,46 @@
+#include "HashState.h"
+#include <cstring>
+
+// writer constructor
+HashStateWriter::HashStateWriter(std::vector<uint8_t>& out) : out(out) {}
+
+// append big-endian value
+void HashStateWriter::putWord(uint64_t value, size_t bytes) {
+    for (size_t i = bytes; i-- > 0;) {
+        out.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+}
+
+// append bytes
+void HashStateWriter::putBytes(const uint8_t* data, size_t length) {
+    out.insert(out.end(), data, data + length);
+}
+
+// reader constructor
+HashStateReader::HashStateReader(const uint8_t* data, size_t length) : data(data), length(length), offset(0) {}
+
+// read big-endian value
+uint64_t HashStateReader::getWord(size_t bytes) {
+    if (bytes > remaining()) {
+        throw std::runtime_error("Truncated hash state");
+    }
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        value = (value << 8) | data[offset++];
+    }
+    return value;
+}
+
+// read bytes
+void HashStateReader::getBytes(uint8_t* out, size_t count) {
+    if (count > remaining()) {
+        throw std::runtime_error("Truncated hash state");
+    }
+    std::memcpy(out, data + offset, count);
+    offset += count;
+}
+
+// unread bytes
+size_t HashStateReader::remaining() const {
+    return length - offset;
+}
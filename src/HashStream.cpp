@@ -0,0 +1,199 @@
+#include "HashStream.h"
+#include <algorithm>
+#include <cstring>
+
+// output buffer constructor
+HashOStreamBuf::HashOStreamBuf(std::streambuf* target, HashAlgorithm algorithm, size_t bufferSize)
+    : target(target), context(algorithm), buffer(std::max<size_t>(1, bufferSize)) {
+    setp(buffer.data(), buffer.data() + buffer.size());
+}
+
+// output buffer destructor
+HashOStreamBuf::~HashOStreamBuf() {
+    flushBuffer();
+}
+
+// forward block and hash what the target accepted
+std::streamsize HashOStreamBuf::forward(const char* data, std::streamsize count) {
+    std::streamsize written = std::max<std::streamsize>(0, target->sputn(data, count));
+    context.update(reinterpret_cast<const uint8_t*>(data), static_cast<size_t>(written));
+    return written;
+}
+
+// hash and forward put area
+bool HashOStreamBuf::flushBuffer() {
+    std::streamsize count = pptr() - pbase();
+    bool ok = count == 0 || forward(pbase(), count) == count;
+    setp(buffer.data(), buffer.data() + buffer.size());
+    return ok;
+}
+
+// flush full buffer
+HashOStreamBuf::int_type HashOStreamBuf::overflow(int_type c) {
+    if (!flushBuffer()) {
+        return traits_type::eof();
+    }
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+// write block
+std::streamsize HashOStreamBuf::xsputn(const char* data, std::streamsize count) {
+    // fits in the remaining buffer
+    if (count < epptr() - pptr()) {
+        std::memcpy(pptr(), data, static_cast<size_t>(count));
+        pbump(static_cast<int>(count));
+        return count;
+    }
+
+    if (!flushBuffer()) {
+        return 0;
+    }
+
+    // blocks of a buffer or more go straight from the caller's memory
+    if (count >= static_cast<std::streamsize>(buffer.size())) {
+        return forward(data, count);
+    }
+
+    std::memcpy(pptr(), data, static_cast<size_t>(count));
+    pbump(static_cast<int>(count));
+    return count;
+}
+
+// flush buffer and target
+int HashOStreamBuf::sync() {
+    if (!flushBuffer()) {
+        return -1;
+    }
+    return target->pubsync();
+}
+
+// finalize as string
+std::string HashOStreamBuf::final() {
+    flushBuffer();
+    return context.final();
+}
+
+// finalize as binary
+void HashOStreamBuf::final(uint8_t* digest) {
+    flushBuffer();
+    context.final(digest);
+}
+
+// input buffer constructor
+HashIStreamBuf::HashIStreamBuf(std::streambuf* source, HashAlgorithm algorithm, size_t bufferSize)
+    : source(source), context(algorithm), buffer(std::max<size_t>(1, bufferSize)) {
+    setg(buffer.data(), buffer.data(), buffer.data());
+    hashedUpTo = buffer.data();
+}
+
+// hash consumed bytes, bytes put back and read again are only hashed once
+void HashIStreamBuf::hashConsumed() {
+    if (gptr() > hashedUpTo) {
+        context.update(reinterpret_cast<const uint8_t*>(hashedUpTo), static_cast<size_t>(gptr() - hashedUpTo));
+        hashedUpTo = gptr();
+    }
+}
+
+// refill buffer
+HashIStreamBuf::int_type HashIStreamBuf::underflow() {
+    if (gptr() < egptr()) {
+        return traits_type::to_int_type(*gptr());
+    }
+
+    hashConsumed();
+    std::streamsize count = source->sgetn(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    setg(buffer.data(), buffer.data(), buffer.data() + std::max<std::streamsize>(0, count));
+    hashedUpTo = buffer.data();
+
+    if (count <= 0) {
+        return traits_type::eof();
+    }
+    return traits_type::to_int_type(*gptr());
+}
+
+// read block
+std::streamsize HashIStreamBuf::xsgetn(char* data, std::streamsize count) {
+    std::streamsize copied = 0;
+
+    // drain buffered bytes first
+    std::streamsize available = std::min(count, static_cast<std::streamsize>(egptr() - gptr()));
+    if (available > 0) {
+        std::memcpy(data, gptr(), static_cast<size_t>(available));
+        gbump(static_cast<int>(available));
+        copied = available;
+    }
+
+    // blocks of a buffer or more are read and hashed in the caller's memory
+    if (count - copied >= static_cast<std::streamsize>(buffer.size())) {
+        hashConsumed();
+        setg(buffer.data(), buffer.data(), buffer.data());
+        hashedUpTo = buffer.data();
+
+        std::streamsize read = source->sgetn(data + copied, count - copied);
+        if (read > 0) {
+            context.update(reinterpret_cast<const uint8_t*>(data + copied), static_cast<size_t>(read));
+            copied += read;
+        }
+        return copied;
+    }
+
+    // smaller remainders go through the buffer
+    while (copied < count) {
+        if (traits_type::eq_int_type(underflow(), traits_type::eof())) {
+            break;
+        }
+        std::streamsize take = std::min(count - copied, static_cast<std::streamsize>(egptr() - gptr()));
+        std::memcpy(data + copied, gptr(), static_cast<size_t>(take));
+        gbump(static_cast<int>(take));
+        copied += take;
+    }
+    return copied;
+}
+
+// finalize as string
+std::string HashIStreamBuf::final() {
+    hashConsumed();
+    return context.final();
+}
+
+// finalize as binary
+void HashIStreamBuf::final(uint8_t* digest) {
+    hashConsumed();
+    context.final(digest);
+}
+
+// output stream constructor
+HashOStream::HashOStream(std::ostream& target, HashAlgorithm algorithm, size_t bufferSize)
+    : std::ostream(nullptr), buf(target.rdbuf(), algorithm, bufferSize) {
+    rdbuf(&buf);
+}
+
+// finalize output stream as string
+std::string HashOStream::final() {
+    return buf.final();
+}
+
+// finalize output stream as binary
+void HashOStream::final(uint8_t* digest) {
+    buf.final(digest);
+}
+
+// input stream constructor
+HashIStream::HashIStream(std::istream& source, HashAlgorithm algorithm, size_t bufferSize)
+    : std::istream(nullptr), buf(source.rdbuf(), algorithm, bufferSize) {
+    rdbuf(&buf);
+}
+
+// finalize input stream as string
+std::string HashIStream::final() {
+    return buf.final();
+}
+
+// finalize input stream as binary
+void HashIStream::final(uint8_t* digest) {
+    buf.final(digest);
+}
@@ -0,0 +1,219 @@
+#include "Keccak.h"
+#include "HashState.h"
+#include <algorithm>
+#include <stdexcept> // Error handling
+
+// round constants
+static constexpr uint64_t RoundConstants[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+    0x000000000000808bULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008aULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800aULL, 0x800000008000000aULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL,
+};
+
+// lanes 1, 2, 8, 12, 17 and 20 are kept inverted, which turns most NOTs of chi into ORs
+static constexpr uint32_t ComplementMask = (1u << 1) | (1u << 2) | (1u << 8) | (1u << 12) | (1u << 17) | (1u << 20);
+
+// rotate bits left n times
+static inline uint64_t rotl(uint64_t x, int n) {
+    return (x << n) | (x >> (64 - n));
+}
+
+// one round from A into E, lanes are A[x + 5 * y]
+static inline void keccakRound(const uint64_t* A, uint64_t* E, uint64_t rc) {
+    // theta
+    uint64_t Ca = A[0] ^ A[5] ^ A[10] ^ A[15] ^ A[20];
+    uint64_t Ce = A[1] ^ A[6] ^ A[11] ^ A[16] ^ A[21];
+    uint64_t Ci = A[2] ^ A[7] ^ A[12] ^ A[17] ^ A[22];
+    uint64_t Co = A[3] ^ A[8] ^ A[13] ^ A[18] ^ A[23];
+    uint64_t Cu = A[4] ^ A[9] ^ A[14] ^ A[19] ^ A[24];
+    uint64_t Da = Cu ^ rotl(Ce, 1);
+    uint64_t De = Ca ^ rotl(Ci, 1);
+    uint64_t Di = Ce ^ rotl(Co, 1);
+    uint64_t Do = Ci ^ rotl(Cu, 1);
+    uint64_t Du = Co ^ rotl(Ca, 1);
+
+    // rho, pi and chi, one output plane at a time
+    uint64_t Ba = A[0] ^ Da;
+    uint64_t Be = rotl(A[6] ^ De, 44);
+    uint64_t Bi = rotl(A[12] ^ Di, 43);
+    uint64_t Bo = rotl(A[18] ^ Do, 21);
+    uint64_t Bu = rotl(A[24] ^ Du, 14);
+    E[0] = Ba ^ (Be | Bi) ^ rc;
+    E[1] = Be ^ (~Bi | Bo);
+    E[2] = Bi ^ (Bo & Bu);
+    E[3] = Bo ^ (Bu | Ba);
+    E[4] = Bu ^ (Ba & Be);
+
+    Ba = rotl(A[3] ^ Do, 28);
+    Be = rotl(A[9] ^ Du, 20);
+    Bi = rotl(A[10] ^ Da, 3);
+    Bo = rotl(A[16] ^ De, 45);
+    Bu = rotl(A[22] ^ Di, 61);
+    E[5] = Ba ^ (Be | Bi);
+    E[6] = Be ^ (Bi & Bo);
+    E[7] = Bi ^ (Bo | ~Bu);
+    E[8] = Bo ^ (Bu | Ba);
+    E[9] = Bu ^ (Ba & Be);
+
+    Ba = rotl(A[1] ^ De, 1);
+    Be = rotl(A[7] ^ Di, 6);
+    Bi = rotl(A[13] ^ Do, 25);
+    Bo = rotl(A[19] ^ Du, 8);
+    Bu = rotl(A[20] ^ Da, 18);
+    E[10] = Ba ^ (Be | Bi);
+    E[11] = Be ^ (Bi & Bo);
+    E[12] = Bi ^ (~Bo & Bu);
+    E[13] = ~Bo ^ (Bu | Ba);
+    E[14] = Bu ^ (Ba & Be);
+
+    Ba = rotl(A[4] ^ Du, 27);
+    Be = rotl(A[5] ^ Da, 36);
+    Bi = rotl(A[11] ^ De, 10);
+    Bo = rotl(A[17] ^ Di, 15);
+    Bu = rotl(A[23] ^ Do, 56);
+    E[15] = Ba ^ (Be & Bi);
+    E[16] = Be ^ (Bi | Bo);
+    E[17] = Bi ^ (~Bo | Bu);
+    E[18] = ~Bo ^ (Bu & Ba);
+    E[19] = Bu ^ (Ba | Be);
+
+    Ba = rotl(A[2] ^ Di, 62);
+    Be = rotl(A[8] ^ Do, 55);
+    Bi = rotl(A[14] ^ Du, 39);
+    Bo = rotl(A[15] ^ Da, 41);
+    Bu = rotl(A[21] ^ De, 2);
+    E[20] = Ba ^ (~Be & Bi);
+    E[21] = ~Be ^ (Bi | Bo);
+    E[22] = Bi ^ (Bo & Bu);
+    E[23] = Bo ^ (Bu | Ba);
+    E[24] = Bu ^ (Ba & Be);
+}
+
+// permutation, two rounds per iteration so the state ping-pongs between A and E
+void Keccak::permute(uint64_t state[25]) {
+    uint64_t E[25];
+    for (size_t round = 0; round < 24; round += 2) {
+        keccakRound(state, E, RoundConstants[round]);
+        keccakRound(E, state, RoundConstants[round + 1]);
+    }
+}
+
+// load little-endian lane
+static inline uint64_t readLane(const uint8_t* p) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) {
+        value = (value << 8) | p[i];
+    }
+    return value;
+}
+
+// sponge constructor
+Keccak::Keccak(size_t rate, uint8_t suffix) : rate(rate), suffix(suffix) {
+    reset();
+}
+
+// reset sponge
+void Keccak::reset() {
+    for (size_t i = 0; i < 25; ++i) {
+        state[i] = (ComplementMask >> i) & 1 ? ~0ULL : 0;
+    }
+    position = 0;
+    squeezing = false;
+}
+
+// absorb data, xor is unaffected by the complemented lanes
+void Keccak::absorb(const uint8_t* data, size_t length) {
+    if (squeezing) {
+        throw std::runtime_error("Keccak sponge already squeezed");
+    }
+
+    // bytes up to a lane boundary
+    while (length > 0 && position % 8 != 0) {
+        state[position / 8] ^= static_cast<uint64_t>(*data++) << (8 * (position % 8));
+        --length;
+        if (++position == rate) {
+            permute(state);
+            position = 0;
+        }
+    }
+
+    // whole lanes
+    while (length >= 8) {
+        state[position / 8] ^= readLane(data);
+        data += 8;
+        length -= 8;
+        position += 8;
+        if (position == rate) {
+            permute(state);
+            position = 0;
+        }
+    }
+
+    // tail
+    for (size_t i = 0; i < length; ++i, ++position) {
+        state[position / 8] ^= static_cast<uint64_t>(data[i]) << (8 * (position % 8));
+    }
+}
+
+// pad10*1 with domain suffix
+void Keccak::pad() {
+    state[position / 8] ^= static_cast<uint64_t>(suffix) << (8 * (position % 8));
+    state[(rate - 1) / 8] ^= 0x80ULL << (8 * ((rate - 1) % 8));
+    permute(state);
+    position = 0;
+    squeezing = true;
+}
+
+// squeeze output
+void Keccak::squeeze(uint8_t* output, size_t length) {
+    if (!squeezing) {
+        pad();
+    }
+
+    while (length > 0) {
+        if (position == rate) {
+            permute(state);
+            position = 0;
+        }
+        size_t take = std::min(length, rate - position);
+        for (size_t i = 0; i < take; ++i, ++position) {
+            size_t lane = position / 8;
+            uint64_t value = (ComplementMask >> lane) & 1 ? ~state[lane] : state[lane];
+            *output++ = static_cast<uint8_t>(value >> (8 * (position % 8)));
+        }
+        length -= take;
+    }
+}
+
+// write sponge state
+void Keccak::saveState(HashStateWriter& writer) const {
+    writer.putWord(rate, 1);
+    writer.putWord(suffix, 1);
+    for (size_t i = 0; i < 25; ++i) {
+        writer.putWord((ComplementMask >> i) & 1 ? ~state[i] : state[i], 8);
+    }
+    writer.putWord(position, 1);
+    writer.putWord(squeezing ? 1 : 0, 1);
+}
+
+// restore sponge state
+void Keccak::loadState(HashStateReader& reader) {
+    size_t savedRate = static_cast<size_t>(reader.getWord(1));
+    uint8_t savedSuffix = static_cast<uint8_t>(reader.getWord(1));
+    if (savedRate != rate || savedSuffix != suffix) {
+        throw std::runtime_error("Invalid hash state");
+    }
+    for (size_t i = 0; i < 25; ++i) {
+        uint64_t lane = reader.getWord(8);
+        state[i] = (ComplementMask >> i) & 1 ? ~lane : lane;
+    }
+    position = static_cast<size_t>(reader.getWord(1));
+    uint64_t flag = reader.getWord(1);
+    if (position > rate || flag > 1 || (flag == 0 && position == rate)) {
+        throw std::runtime_error("Invalid hash state");
+    }
+    squeezing = flag == 1;
+}
@@ -1,97 +1,194 @@
 #include "MD5.h"
+#include "HashState.h"
 #include <cstring>
 #include <cstdio>
+#include <algorithm>
 
-// rotate bits left
-uint32_t MD5::leftRotate(uint32_t x, uint32_t n) {
-    return (x << n) | (x >> (32 - n));
+// md5 constructor
+MD5::MD5() {
+    reset();
 }
 
-// pad data to make its length congruent to 448 mod 512
-std::vector<uint8_t> MD5::paddata(const std::string& data) {
-    std::vector<uint8_t> padded(data.begin(), data.end());
-    padded.push_back(0x80); // append '1' followed by '0's (0x80)
+// reset state with constants
+void MD5::reset() {
+    state[0] = 0x67452301;
+    state[1] = 0xefcdab89;
+    state[2] = 0x98badcfe;
+    state[3] = 0x10325476;
 
-    // add zeros until length congruent to 448 mod 512
-    while ((padded.size() * 8) % 512 != 448) {
-        padded.push_back(0x00);
+    bitCount = 0;
+    bufferIndex = 0;
+}
+
+// update state
+void MD5::update(const std::string& data) {
+    update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+}
+
+// update state with raw bytes
+void MD5::update(const uint8_t* data, size_t length) {
+    if (length == 0) {
+        return;
+    }
+    bitCount += static_cast<uint64_t>(length) * 8;
+
+    // complete a partially filled buffer first
+    if (bufferIndex > 0) {
+        size_t take = std::min(length, BlockSize - bufferIndex);
+        std::memcpy(buffer + bufferIndex, data, take);
+        bufferIndex += take;
+        data += take;
+        length -= take;
+
+        if (bufferIndex < BlockSize) {
+            return;
+        }
+        processBlock(state[0], state[1], state[2], state[3], buffer);
+        bufferIndex = 0;
     }
 
+    // process full blocks straight from the input
+    while (length >= BlockSize) {
+        processBlock(state[0], state[1], state[2], state[3], data);
+        data += BlockSize;
+        length -= BlockSize;
+    }
+
+    // keep the tail for the next call
+    if (length > 0) {
+        std::memcpy(buffer, data, length);
+        bufferIndex = length;
+    }
+}
+
+// pad buffer so its length is congruent to 448 mod 512, then append length
+void MD5::padBuffer() {
+    buffer[bufferIndex++] = 0x80; // append '1' followed by '0's (0x80)
+
+    // process block if no room for the length
+    if (bufferIndex > BlockSize - 8) {
+        std::memset(buffer + bufferIndex, 0, BlockSize - bufferIndex);
+        processBlock(state[0], state[1], state[2], state[3], buffer);
+        bufferIndex = 0;
+    }
+
+    // add zeros until 8 bytes are left
+    std::memset(buffer + bufferIndex, 0, BlockSize - 8 - bufferIndex);
+
     // append the original length in bits as little-endian value
-    uint64_t dataBitLength = data.size() * 8;
     for (int i = 0; i < 8; ++i) {
-        padded.push_back(static_cast<uint8_t>(dataBitLength >> (i * 8)));
+        buffer[BlockSize - 8 + i] = static_cast<uint8_t>(bitCount >> (i * 8));
     }
+    processBlock(state[0], state[1], state[2], state[3], buffer);
+}
+
+// round 1 step, F selects c or d based on b
+static inline void md5F(uint32_t& a, uint32_t b, uint32_t c, uint32_t d, uint32_t x, uint32_t t, uint32_t s) {
+    a += (d ^ (b & (c ^ d))) + x + t;
+    a = b + ((a << s) | (a >> (32 - s)));
+}
 
-    return padded;
+// round 2 step, G selects b or c based on d
+static inline void md5G(uint32_t& a, uint32_t b, uint32_t c, uint32_t d, uint32_t x, uint32_t t, uint32_t s) {
+    a += (c ^ (d & (b ^ c))) + x + t;
+    a = b + ((a << s) | (a >> (32 - s)));
+}
+
+// round 3 step, H is parity of b,c,d
+static inline void md5H(uint32_t& a, uint32_t b, uint32_t c, uint32_t d, uint32_t x, uint32_t t, uint32_t s) {
+    a += (b ^ c ^ d) + x + t;
+    a = b + ((a << s) | (a >> (32 - s)));
+}
+
+// round 4 step
+static inline void md5I(uint32_t& a, uint32_t b, uint32_t c, uint32_t d, uint32_t x, uint32_t t, uint32_t s) {
+    a += (c ^ (b | ~d)) + x + t;
+    a = b + ((a << s) | (a >> (32 - s)));
 }
 
 // process block
 void MD5::processBlock(uint32_t& A, uint32_t& B, uint32_t& C, uint32_t& D, const uint8_t* block) {
-    // Predefined constants
-    static const uint32_t T[64] = {
-        0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee,
-        0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
-        0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be,
-        0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
-        0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa,
-        0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
-        0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed,
-        0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
-        0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c,
-        0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
-        0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05,
-        0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
-        0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039,
-        0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
-        0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1,
-        0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
-    };
-
-    // Predefined shift amounts
-    static const uint32_t S[64] = {
-        7, 12, 17, 22,  7, 12, 17, 22,  7, 12, 17, 22,  7, 12, 17, 22,
-        5,  9, 14, 20,  5,  9, 14, 20,  5,  9, 14, 20,  5,  9, 14, 20,
-        4, 11, 16, 23,  4, 11, 16, 23,  4, 11, 16, 23,  4, 11, 16, 23,
-        6, 10, 15, 21,  6, 10, 15, 21,  6, 10, 15, 21,  6, 10, 15, 21
-    };
-
     // decode block into integer
     uint32_t X[16];
     for (int i = 0; i < 16; ++i) {
         X[i] = (block[i * 4]) | (block[i * 4 + 1] << 8) |
-               (block[i * 4 + 2] << 16) | (block[i * 4 + 3] << 24);
+               (block[i * 4 + 2] << 16) | (static_cast<uint32_t>(block[i * 4 + 3]) << 24);
     }
 
     // initialize variables
     uint32_t a = A, b = B, c = C, d = D;
 
-    // md5 transformation loop
-    for (int i = 0; i < 64; ++i) {
-        uint32_t f, g;
-
-        // compute function based on round
-        if (i < 16) {
-            f = (b & c) | (~b & d);
-            g = i;
-        } else if (i < 32) {
-            f = (d & b) | (~d & c);
-            g = (5 * i + 1) % 16;
-        } else if (i < 48) {
-            f = b ^ c ^ d;
-            g = (3 * i + 5) % 16;
-        } else {
-            f = c ^ (b | ~d);
-            g = (7 * i) % 16;
-        }
-
-        // update variables
-        uint32_t temp = d;
-        d = c;
-        c = b;
-        b = b + leftRotate(a + f + X[g] + T[i], S[i]);
-        a = temp;
-    }
+    // unrolled transformation, message index, constant and shift fixed per step
+    md5F(a, b, c, d, X[0], 0xd76aa478, 7);
+    md5F(d, a, b, c, X[1], 0xe8c7b756, 12);
+    md5F(c, d, a, b, X[2], 0x242070db, 17);
+    md5F(b, c, d, a, X[3], 0xc1bdceee, 22);
+    md5F(a, b, c, d, X[4], 0xf57c0faf, 7);
+    md5F(d, a, b, c, X[5], 0x4787c62a, 12);
+    md5F(c, d, a, b, X[6], 0xa8304613, 17);
+    md5F(b, c, d, a, X[7], 0xfd469501, 22);
+    md5F(a, b, c, d, X[8], 0x698098d8, 7);
+    md5F(d, a, b, c, X[9], 0x8b44f7af, 12);
+    md5F(c, d, a, b, X[10], 0xffff5bb1, 17);
+    md5F(b, c, d, a, X[11], 0x895cd7be, 22);
+    md5F(a, b, c, d, X[12], 0x6b901122, 7);
+    md5F(d, a, b, c, X[13], 0xfd987193, 12);
+    md5F(c, d, a, b, X[14], 0xa679438e, 17);
+    md5F(b, c, d, a, X[15], 0x49b40821, 22);
+
+    // round 2
+    md5G(a, b, c, d, X[1], 0xf61e2562, 5);
+    md5G(d, a, b, c, X[6], 0xc040b340, 9);
+    md5G(c, d, a, b, X[11], 0x265e5a51, 14);
+    md5G(b, c, d, a, X[0], 0xe9b6c7aa, 20);
+    md5G(a, b, c, d, X[5], 0xd62f105d, 5);
+    md5G(d, a, b, c, X[10], 0x02441453, 9);
+    md5G(c, d, a, b, X[15], 0xd8a1e681, 14);
+    md5G(b, c, d, a, X[4], 0xe7d3fbc8, 20);
+    md5G(a, b, c, d, X[9], 0x21e1cde6, 5);
+    md5G(d, a, b, c, X[14], 0xc33707d6, 9);
+    md5G(c, d, a, b, X[3], 0xf4d50d87, 14);
+    md5G(b, c, d, a, X[8], 0x455a14ed, 20);
+    md5G(a, b, c, d, X[13], 0xa9e3e905, 5);
+    md5G(d, a, b, c, X[2], 0xfcefa3f8, 9);
+    md5G(c, d, a, b, X[7], 0x676f02d9, 14);
+    md5G(b, c, d, a, X[12], 0x8d2a4c8a, 20);
+
+    // round 3
+    md5H(a, b, c, d, X[5], 0xfffa3942, 4);
+    md5H(d, a, b, c, X[8], 0x8771f681, 11);
+    md5H(c, d, a, b, X[11], 0x6d9d6122, 16);
+    md5H(b, c, d, a, X[14], 0xfde5380c, 23);
+    md5H(a, b, c, d, X[1], 0xa4beea44, 4);
+    md5H(d, a, b, c, X[4], 0x4bdecfa9, 11);
+    md5H(c, d, a, b, X[7], 0xf6bb4b60, 16);
+    md5H(b, c, d, a, X[10], 0xbebfbc70, 23);
+    md5H(a, b, c, d, X[13], 0x289b7ec6, 4);
+    md5H(d, a, b, c, X[0], 0xeaa127fa, 11);
+    md5H(c, d, a, b, X[3], 0xd4ef3085, 16);
+    md5H(b, c, d, a, X[6], 0x04881d05, 23);
+    md5H(a, b, c, d, X[9], 0xd9d4d039, 4);
+    md5H(d, a, b, c, X[12], 0xe6db99e5, 11);
+    md5H(c, d, a, b, X[15], 0x1fa27cf8, 16);
+    md5H(b, c, d, a, X[2], 0xc4ac5665, 23);
+
+    // round 4
+    md5I(a, b, c, d, X[0], 0xf4292244, 6);
+    md5I(d, a, b, c, X[7], 0x432aff97, 10);
+    md5I(c, d, a, b, X[14], 0xab9423a7, 15);
+    md5I(b, c, d, a, X[5], 0xfc93a039, 21);
+    md5I(a, b, c, d, X[12], 0x655b59c3, 6);
+    md5I(d, a, b, c, X[3], 0x8f0ccc92, 10);
+    md5I(c, d, a, b, X[10], 0xffeff47d, 15);
+    md5I(b, c, d, a, X[1], 0x85845dd1, 21);
+    md5I(a, b, c, d, X[8], 0x6fa87e4f, 6);
+    md5I(d, a, b, c, X[15], 0xfe2ce6e0, 10);
+    md5I(c, d, a, b, X[6], 0xa3014314, 15);
+    md5I(b, c, d, a, X[13], 0x4e0811a1, 21);
+    md5I(a, b, c, d, X[4], 0xf7537e82, 6);
+    md5I(d, a, b, c, X[11], 0xbd3af235, 10);
+    md5I(c, d, a, b, X[2], 0x2ad7d2bb, 15);
+    md5I(b, c, d, a, X[9], 0xeb86d391, 21);
 
     // update hash values
     A += a;
@@ -100,36 +197,57 @@ void MD5::processBlock(uint32_t& A, uint32_t& B, uint32_t& C, uint32_t& D, const
     D += d;
 }
 
-// compute hash
-std::string MD5::hash(const std::string& input) {
-    // initialize hasv values with constants
-    uint32_t A = 0x67452301;
-    uint32_t B = 0xefcdab89;
-    uint32_t C = 0x98badcfe;
-    uint32_t D = 0x10325476;
-
-    // pad input data
-    auto padded = paddata(input);
-
-    // process each block of padded data
-    for (size_t i = 0; i < padded.size(); i += 64) {
-        processBlock(A, B, C, D, &padded[i]);
-    }
-
-    // combine hash values into full hash
-    uint8_t hash[16];
-    memcpy(hash, &A, 4);
-    memcpy(hash + 4, &B, 4);
-    memcpy(hash + 8, &C, 4);
-    memcpy(hash + 12, &D, 4);
+// finalize hash
+std::string MD5::final() {
+    uint8_t hash[OutputSize];
+    final(hash);
 
     // convert bytes into hex 
     std::string result;
     for (uint8_t byte : hash) {
         char buf[3];
-        sprintf(buf, "%02x", byte);
+        snprintf(buf, sizeof(buf), "%02x", byte);
         result += buf;
     }
 
     return result;
 }
+
+// finalize binary hash
+void MD5::final(uint8_t digest[OutputSize]) {
+    padBuffer();
+
+    // combine hash values into full hash, little-endian
+    for (int i = 0; i < 4; ++i) {
+        digest[i * 4] = static_cast<uint8_t>(state[i]);
+        digest[i * 4 + 1] = static_cast<uint8_t>(state[i] >> 8);
+        digest[i * 4 + 2] = static_cast<uint8_t>(state[i] >> 16);
+        digest[i * 4 + 3] = static_cast<uint8_t>(state[i] >> 24);
+    }
+
+    reset(); // reset state
+}
+
+// compute binary hash
+void MD5::hash(const uint8_t* data, size_t length, uint8_t digest[OutputSize]) {
+    MD5 md5;
+    md5.update(data, length);
+    md5.final(digest);
+}
+
+// compute hash
+std::string MD5::hash(const std::string& input) {
+    MD5 md5;
+    md5.update(input);
+    return md5.final();
+}
+
+// write streaming state
+void MD5::saveState(HashStateWriter& writer) const {
+    saveBlockState(writer, state, bitCount, buffer, bufferIndex);
+}
+
+// restore streaming state
+void MD5::loadState(HashStateReader& reader) {
+    loadBlockState(reader, state, bitCount, buffer, bufferIndex, BlockSize);
+}
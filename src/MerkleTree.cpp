@@ -0,0 +1,226 @@
+#include "MerkleTree.h"
+#include "HMAC.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept> // Error handling
+
+// domain separation prefixes
+static const uint8_t LeafPrefix = 0x00;
+static const uint8_t NodePrefix = 0x01;
+
+// most bytes read ahead by buildFile, whole leaves and at least one
+static constexpr size_t MaxBatchBytes = 64 << 20;
+
+// check algorithm
+static HashAlgorithm treeAlgorithm(HashAlgorithm algorithm) {
+    switch (algorithm) {
+        case HashAlgorithm::SHA1:
+        case HashAlgorithm::SHA224:
+        case HashAlgorithm::SHA256:
+        case HashAlgorithm::SHA384:
+        case HashAlgorithm::SHA512:
+        case HashAlgorithm::SHA512_256:
+        case HashAlgorithm::SHA512_224:
+            return algorithm;
+        default:
+            throw std::runtime_error("Unsupported algorithm for Merkle tree");
+    }
+}
+
+// context with a prefix byte fed
+static HashContext prefixed(HashAlgorithm algorithm, uint8_t prefix) {
+    HashContext context(treeAlgorithm(algorithm));
+    context.update(&prefix, 1);
+    return context;
+}
+
+// tree constructor
+MerkleTree::MerkleTree(HashAlgorithm algorithm, size_t leafSize)
+    : algorithm(algorithm), chunkSize(std::max<size_t>(1, leafSize)), size(HashLite::digestSize(algorithm)),
+      leafPrefix(prefixed(algorithm, LeafPrefix)), nodePrefix(prefixed(algorithm, NodePrefix)) {}
+
+// build on shared pool
+void MerkleTree::build(const uint8_t* data, size_t length) {
+    build(data, length, ThreadPool::shared());
+}
+
+// build from memory
+void MerkleTree::build(const uint8_t* data, size_t length, ThreadPool& pool) {
+    size_t count = (length + chunkSize - 1) / chunkSize;
+    levels.assign(1, std::vector<uint8_t>(count * size));
+    std::vector<uint8_t>& leaves = levels[0];
+
+    pool.parallelFor(count, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            size_t offset = i * chunkSize;
+            leafPrefix.finalWith(data + offset, std::min(chunkSize, length - offset), leaves.data() + i * size);
+        }
+    });
+    buildLevels(pool);
+}
+
+// build file on shared pool
+void MerkleTree::buildFile(const std::string& path) {
+    buildFile(path, ThreadPool::shared());
+}
+
+// build from file
+void MerkleTree::buildFile(const std::string& path, ThreadPool& pool) {
+    std::ifstream file(path, std::ios::binary); // open file as binary
+    if (!file) {
+        throw std::runtime_error("Unable to open file: " + path);
+    }
+
+    levels.assign(1, std::vector<uint8_t>());
+    std::vector<uint8_t>& leaves = levels[0];
+    // a few leaves per worker, bounded so large leaves on many workers do not exhaust memory
+    size_t batchLeaves = std::max<size_t>(1, std::min(pool.size() * 2, MaxBatchBytes / chunkSize));
+    std::vector<char> batch(batchLeaves * chunkSize);
+
+    while (file) {
+        file.read(batch.data(), static_cast<std::streamsize>(batch.size()));
+        size_t read = static_cast<size_t>(file.gcount());
+        if (read == 0) {
+            break;
+        }
+
+        // hash the leaves of this batch in parallel
+        size_t first = leaves.size() / size;
+        size_t count = (read + chunkSize - 1) / chunkSize;
+        leaves.resize((first + count) * size);
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(batch.data());
+        pool.parallelFor(count, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                size_t offset = i * chunkSize;
+                leafPrefix.finalWith(data + offset, std::min(chunkSize, read - offset),
+                                     leaves.data() + (first + i) * size);
+            }
+        });
+    }
+    if (file.bad()) {
+        throw std::runtime_error("Unable to read file: " + path);
+    }
+    buildLevels(pool);
+}
+
+// hash levels above the leaves
+void MerkleTree::buildLevels(ThreadPool& pool) {
+    while (levels.back().size() > size) {
+        const std::vector<uint8_t>& below = levels.back();
+        size_t count = below.size() / size;
+        std::vector<uint8_t> above(((count + 1) / 2) * size);
+
+        // children of a node are adjacent, so each pair is hashed in place
+        pool.parallelFor(count / 2, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                nodePrefix.finalWith(below.data() + 2 * i * size, 2 * size, above.data() + i * size);
+            }
+        });
+        if (count % 2 != 0) {
+            std::memcpy(above.data() + (count / 2) * size, below.data() + (count - 1) * size, size);
+        }
+        levels.push_back(std::move(above));
+    }
+}
+
+// rehash one leaf path
+void MerkleTree::updateLeaf(size_t index, const uint8_t* data, size_t length) {
+    if (index >= leafCount()) {
+        throw std::runtime_error("Leaf index out of range");
+    }
+    // only chunks build would produce keep the root reproducible: full leaves, a shorter last one
+    bool last = index + 1 == leafCount();
+    if (length == 0 || length > chunkSize || (!last && length != chunkSize)) {
+        throw std::runtime_error("Invalid leaf length");
+    }
+
+    leafPrefix.finalWith(data, length, levels[0].data() + index * size);
+    for (size_t level = 1; level < levels.size(); ++level) {
+        size_t count = levels[level - 1].size() / size;
+        size_t pair = index & ~static_cast<size_t>(1);
+        uint8_t* parent = levels[level].data() + (index / 2) * size;
+        if (pair + 1 < count) {
+            nodePrefix.finalWith(levels[level - 1].data() + pair * size, 2 * size, parent);
+        } else {
+            std::memcpy(parent, levels[level - 1].data() + index * size, size); // unpaired node moves up
+        }
+        index /= 2;
+    }
+}
+
+// root hash
+std::vector<uint8_t> MerkleTree::root() const {
+    if (levels.empty() || levels.back().empty()) {
+        std::vector<uint8_t> empty(size);
+        HashContext(algorithm).final(empty.data());
+        return empty;
+    }
+    return levels.back();
+}
+
+// leaf count
+size_t MerkleTree::leafCount() const {
+    return levels.empty() ? 0 : levels[0].size() / size;
+}
+
+// leaf size
+size_t MerkleTree::leafSize() const {
+    return chunkSize;
+}
+
+// collect sibling hashes
+MerkleProof MerkleTree::proof(size_t index) const {
+    if (index >= leafCount()) {
+        throw std::runtime_error("Leaf index out of range");
+    }
+
+    MerkleProof result;
+    result.index = index;
+    result.leafCount = leafCount();
+    for (size_t level = 0; level + 1 < levels.size(); ++level) {
+        size_t count = levels[level].size() / size;
+        size_t sibling = index ^ 1;
+        if (sibling < count) {
+            const uint8_t* hash = levels[level].data() + sibling * size;
+            result.path.emplace_back(hash, hash + size);
+        }
+        index /= 2;
+    }
+    return result;
+}
+
+// recompute root from chunk and proof
+bool MerkleTree::verify(HashAlgorithm algorithm, const uint8_t* chunk, size_t length,
+                        const MerkleProof& proof, const uint8_t* root) {
+    if (proof.index >= proof.leafCount) {
+        return false;
+    }
+
+    size_t size = HashLite::digestSize(algorithm);
+    std::vector<uint8_t> pair(2 * size); // running hash is kept in the left half
+    prefixed(algorithm, LeafPrefix).finalWith(chunk, length, pair.data());
+    HashContext nodePrefix = prefixed(algorithm, NodePrefix);
+
+    size_t index = proof.index;
+    size_t used = 0;
+    for (size_t count = proof.leafCount; count > 1; count = (count + 1) / 2) {
+        if ((index ^ 1) < count) {
+            if (used == proof.path.size() || proof.path[used].size() != size) {
+                return false;
+            }
+            const std::vector<uint8_t>& sibling = proof.path[used++];
+            if (index % 2 == 0) {
+                std::memcpy(pair.data() + size, sibling.data(), size);
+            } else {
+                std::memcpy(pair.data() + size, pair.data(), size);
+                std::memcpy(pair.data(), sibling.data(), size);
+            }
+            nodePrefix.finalWith(pair.data(), 2 * size, pair.data());
+        }
+        index /= 2;
+    }
+
+    return used == proof.path.size() && HMAC::constantTimeEqual(pair.data(), root, size);
+}
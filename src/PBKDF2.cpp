@@ -0,0 +1,103 @@
+#include "PBKDF2.h"
+#include "HMAC.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <stdexcept> // Error handling
+
+// compute output block T_index, the keyed HMAC holds the password midstates
+static void deriveBlock(const HMAC& mac, const uint8_t* salt, size_t saltLength, uint32_t iterations,
+                        uint32_t index, uint8_t* block, size_t blockLength) {
+    size_t size = mac.digestSize();
+    uint8_t u[64];
+    uint8_t t[64];
+
+    // U_1 = PRF(P, S || INT(i))
+    std::vector<uint8_t> first(salt, salt + saltLength);
+    first.push_back(static_cast<uint8_t>(index >> 24));
+    first.push_back(static_cast<uint8_t>(index >> 16));
+    first.push_back(static_cast<uint8_t>(index >> 8));
+    first.push_back(static_cast<uint8_t>(index));
+    mac.compute(first.data(), first.size(), u);
+    std::copy(u, u + size, t);
+
+    // U_j = PRF(P, U_{j-1}), T = U_1 ^ ... ^ U_c
+    for (uint32_t j = 1; j < iterations; ++j) {
+        mac.compute(u, size, u);
+        for (size_t k = 0; k < size; ++k) {
+            t[k] ^= u[k];
+        }
+    }
+
+    std::copy(t, t + blockLength, block);
+}
+
+// check parameters
+static void checkIterations(uint32_t iterations) {
+    if (iterations == 0) {
+        throw std::runtime_error("PBKDF2 needs at least one iteration");
+    }
+}
+
+// derive on calling thread
+void PBKDF2::deriveSerial(HashAlgorithm algorithm, const uint8_t* password, size_t passwordLength,
+                          const uint8_t* salt, size_t saltLength, uint32_t iterations,
+                          uint8_t* output, size_t outputLength) {
+    checkIterations(iterations);
+    HMAC mac(algorithm, password, passwordLength);
+    size_t size = mac.digestSize();
+
+    for (size_t offset = 0, index = 1; offset < outputLength; offset += size, ++index) {
+        deriveBlock(mac, salt, saltLength, iterations, static_cast<uint32_t>(index), output + offset,
+                    std::min(size, outputLength - offset));
+    }
+}
+
+// derive with output blocks in parallel
+void PBKDF2::derive(HashAlgorithm algorithm, const uint8_t* password, size_t passwordLength,
+                    const uint8_t* salt, size_t saltLength, uint32_t iterations,
+                    uint8_t* output, size_t outputLength) {
+    checkIterations(iterations);
+    HMAC mac(algorithm, password, passwordLength);
+    size_t size = mac.digestSize();
+    size_t blocks = (outputLength + size - 1) / size;
+
+    // blocks are independent chains, only the midstates are shared
+    ThreadPool::shared().parallelFor(blocks, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            size_t offset = i * size;
+            deriveBlock(mac, salt, saltLength, iterations, static_cast<uint32_t>(i + 1), output + offset,
+                        std::min(size, outputLength - offset));
+        }
+    });
+}
+
+// derive from strings
+std::vector<uint8_t> PBKDF2::derive(HashAlgorithm algorithm, const std::string& password,
+                                    const std::string& salt, uint32_t iterations, size_t outputLength) {
+    std::vector<uint8_t> output(outputLength);
+    derive(algorithm, reinterpret_cast<const uint8_t*>(password.data()), password.size(),
+           reinterpret_cast<const uint8_t*>(salt.data()), salt.size(), iterations, output.data(), outputLength);
+    return output;
+}
+
+// derive many keys on shared pool
+void PBKDF2::deriveBatch(HashAlgorithm algorithm, const HashInput* passwords, size_t count,
+                         const uint8_t* salt, size_t saltLength, uint32_t iterations,
+                         uint8_t* outputs, size_t outputLength) {
+    deriveBatch(algorithm, passwords, count, salt, saltLength, iterations, outputs, outputLength, ThreadPool::shared());
+}
+
+// derive many keys on given pool
+void PBKDF2::deriveBatch(HashAlgorithm algorithm, const HashInput* passwords, size_t count,
+                         const uint8_t* salt, size_t saltLength, uint32_t iterations,
+                         uint8_t* outputs, size_t outputLength, ThreadPool& pool) {
+    checkIterations(iterations);
+    HMAC::blockSize(algorithm); // reject unsupported algorithms before queuing work
+
+    pool.parallelFor(count, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            deriveSerial(algorithm, passwords[i].data, passwords[i].length, salt, saltLength, iterations,
+                         outputs + i * outputLength, outputLength);
+        }
+    });
+}
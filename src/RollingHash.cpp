@@ -0,0 +1,197 @@
+#include "RollingHash.h"
+#include <array>
+#include <stdexcept> // Error handling
+
+// rotate bits left, any count
+static inline uint64_t rotl(uint64_t x, size_t n) {
+    n &= 63;
+    return n == 0 ? x : (x << n) | (x >> (64 - n));
+}
+
+// byte values of Buzhash, fixed pseudo-random values so hashes never change between versions
+static constexpr std::array<uint64_t, 256> makeTable() {
+    std::array<uint64_t, 256> table{};
+    uint64_t state = 0x42757A68617368ULL; // "Buzhash"
+    for (uint64_t& value : table) {
+        state += 0x9E3779B97F4A7C15ULL;
+        uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        value = z ^ (z >> 31);
+    }
+    return table;
+}
+
+static constexpr std::array<uint64_t, 256> Table = makeTable();
+
+// initialize Rabin-Karp window
+RabinKarp::RabinKarp(uint64_t base) : base(base), inverse(base), power(1), hash(0), count(0) {
+    if ((base & 1) == 0) {
+        throw std::runtime_error("Invalid rolling hash base");
+    }
+    // each Newton step doubles the correct low bits of the inverse
+    for (int i = 0; i < 5; ++i) {
+        inverse *= 2 - base * inverse;
+    }
+}
+
+// append byte
+void RabinKarp::add(uint8_t in) {
+    hash = hash * base + in;
+    power *= base;
+    ++count;
+}
+
+// append bytes
+void RabinKarp::add(const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        add(data[i]);
+    }
+}
+
+// drop oldest byte
+void RabinKarp::remove(uint8_t out) {
+    power *= inverse;
+    hash -= out * power;
+    --count;
+}
+
+// slide window
+void RabinKarp::roll(uint8_t out, uint8_t in) {
+    hash = hash * base + in - out * power;
+}
+
+// slide window recording each hash
+void RabinKarp::roll(const uint8_t* window, size_t steps, uint64_t* values) {
+    uint64_t h = hash;
+    for (size_t i = 0; i < steps; ++i) {
+        h = h * base + window[i + count] - window[i] * power;
+        values[i] = h;
+    }
+    hash = h;
+}
+
+// slide window by count bytes
+void RabinKarp::advance(const uint8_t* window, size_t steps) {
+    if (steps >= count) {
+        hash = hashValue(window + steps, count, base);
+        return;
+    }
+    for (size_t i = 0; i < steps; ++i) {
+        roll(window[i], window[i + count]);
+    }
+}
+
+// window hash
+uint64_t RabinKarp::value() const {
+    return hash;
+}
+
+// window bytes
+size_t RabinKarp::size() const {
+    return count;
+}
+
+// empty window
+void RabinKarp::reset() {
+    power = 1;
+    hash = 0;
+    count = 0;
+}
+
+// hash of a whole window
+uint64_t RabinKarp::hashValue(const uint8_t* data, size_t length, uint64_t base) {
+    uint64_t hash = 0;
+    for (size_t i = 0; i < length; ++i) {
+        hash = hash * base + data[i];
+    }
+    return hash;
+}
+
+// initialize Buzhash window
+Buzhash::Buzhash() : hash(0), count(0) {}
+
+// append byte
+void Buzhash::add(uint8_t in) {
+    hash = rotl(hash, 1) ^ Table[in];
+    ++count;
+}
+
+// append bytes
+void Buzhash::add(const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        add(data[i]);
+    }
+}
+
+// drop oldest byte, it has been rotated once for every later byte
+void Buzhash::remove(uint8_t out) {
+    --count;
+    hash ^= rotl(Table[out], count);
+}
+
+// slide window
+void Buzhash::roll(uint8_t out, uint8_t in) {
+    hash = rotl(hash, 1) ^ rotl(Table[out], count) ^ Table[in];
+}
+
+// slide window recording each hash
+void Buzhash::roll(const uint8_t* window, size_t steps, uint64_t* values) {
+    uint64_t h = hash;
+    for (size_t i = 0; i < steps; ++i) {
+        h = rotl(h, 1) ^ rotl(Table[window[i]], count) ^ Table[window[i + count]];
+        values[i] = h;
+    }
+    hash = h;
+}
+
+// slide window by count bytes
+void Buzhash::advance(const uint8_t* window, size_t steps) {
+    if (steps >= count) {
+        hash = hashValue(window + steps, count);
+        return;
+    }
+    for (size_t i = 0; i < steps; ++i) {
+        roll(window[i], window[i + count]);
+    }
+}
+
+// window hash
+uint64_t Buzhash::value() const {
+    return hash;
+}
+
+// window bytes
+size_t Buzhash::size() const {
+    return count;
+}
+
+// empty window
+void Buzhash::reset() {
+    hash = 0;
+    count = 0;
+}
+
+// hash of a whole window
+uint64_t Buzhash::hashValue(const uint8_t* data, size_t length) {
+    uint64_t hash = 0;
+    for (size_t i = 0; i < length; ++i) {
+        hash = rotl(hash, 1) ^ Table[data[i]];
+    }
+    return hash;
+}
+
+// hashes of every window
+void Buzhash::hashWindows(const uint8_t* data, size_t length, size_t window, uint64_t* out) {
+    if (window == 0) {
+        throw std::runtime_error("Invalid window size");
+    }
+    if (length < window) {
+        return;
+    }
+
+    Buzhash rolling;
+    rolling.add(data, window);
+    out[0] = rolling.value();
+    rolling.roll(data, length - window, out + 1);
+}
@@ -1,7 +1,9 @@
 #include "SHA1.h"
+#include "HashState.h"
 #include <sstream>
 #include <iomanip>
 #include <cstring> 
+#include <algorithm>
 
 // sha1 constructor
 SHA1::SHA1() {
@@ -21,24 +23,44 @@ void SHA1::reset() {
     std::memset(buffer, 0, BlockSize);
 }
 
-// rotate left
-uint32_t SHA1::leftRotate(uint32_t value, size_t count) {
-    return (value << count) | (value >> (32 - count));
-}
-
 // update state
 void SHA1::update(const std::string& data) {
-    const uint8_t* input = reinterpret_cast<const uint8_t*>(data.data());
-    size_t length = data.size();
+    update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+}
 
-    for (size_t i = 0; i < length; ++i) {
-        buffer[bufferIndex++] = input[i];
-        bitCount += 8; // increment count
+// update state with raw bytes
+void SHA1::update(const uint8_t* input, size_t length) {
+    if (length == 0) {
+        return;
+    }
+    bitCount += static_cast<uint64_t>(length) * 8;
+
+    // complete a partially filled buffer first
+    if (bufferIndex > 0) {
+        size_t take = std::min(length, BlockSize - bufferIndex);
+        std::memcpy(buffer + bufferIndex, input, take);
+        bufferIndex += take;
+        input += take;
+        length -= take;
 
-        if (bufferIndex == BlockSize) { // full buffer processing
-            processBlock();
-            bufferIndex = 0;
+        if (bufferIndex < BlockSize) {
+            return;
         }
+        processBlock(buffer);
+        bufferIndex = 0;
+    }
+
+    // process full blocks straight from the input
+    while (length >= BlockSize) {
+        processBlock(input);
+        input += BlockSize;
+        length -= BlockSize;
+    }
+
+    // keep the tail for the next call
+    if (length > 0) {
+        std::memcpy(buffer, input, length);
+        bufferIndex = length;
     }
 }
 
@@ -51,7 +73,7 @@ void SHA1::padBuffer() {
         while (bufferIndex < BlockSize) {
             buffer[bufferIndex++] = 0x00;
         }
-        processBlock();
+        processBlock(buffer);
         bufferIndex = 0;
     }
 
@@ -67,21 +89,47 @@ void SHA1::padBuffer() {
     }
 }
 
+// expand next schedule word in place, w holds a 16 word window
+static inline uint32_t sha1Expand(uint32_t w[16], size_t i) {
+    uint32_t x = w[(i + 13) & 15] ^ w[(i + 8) & 15] ^ w[(i + 2) & 15] ^ w[i];
+    w[i] = (x << 1) | (x >> 31);
+    return w[i];
+}
+
+// rounds 0-19, choose function
+static inline void sha1Round1(uint32_t a, uint32_t& b, uint32_t c, uint32_t d, uint32_t& e, uint32_t w) {
+    e += ((a << 5) | (a >> 27)) + (d ^ (b & (c ^ d))) + 0x5A827999 + w;
+    b = (b << 30) | (b >> 2);
+}
+
+// rounds 20-39, parity function
+static inline void sha1Round2(uint32_t a, uint32_t& b, uint32_t c, uint32_t d, uint32_t& e, uint32_t w) {
+    e += ((a << 5) | (a >> 27)) + (b ^ c ^ d) + 0x6ED9EBA1 + w;
+    b = (b << 30) | (b >> 2);
+}
+
+// rounds 40-59, majority function
+static inline void sha1Round3(uint32_t a, uint32_t& b, uint32_t c, uint32_t d, uint32_t& e, uint32_t w) {
+    e += ((a << 5) | (a >> 27)) + ((b & c) | (d & (b | c))) + 0x8F1BBCDC + w;
+    b = (b << 30) | (b >> 2);
+}
+
+// rounds 60-79, parity function
+static inline void sha1Round4(uint32_t a, uint32_t& b, uint32_t c, uint32_t d, uint32_t& e, uint32_t w) {
+    e += ((a << 5) | (a >> 27)) + (b ^ c ^ d) + 0xCA62C1D6 + w;
+    b = (b << 30) | (b >> 2);
+}
+
 // process block
-void SHA1::processBlock() {
-    uint32_t w[80];
+void SHA1::processBlock(const uint8_t* block) {
+    uint32_t w[16];
 
-    // initialize 16 words from buffer
+    // initialize 16 words from block, later words are expanded in place
     for (size_t i = 0; i < 16; ++i) {
-        w[i] = (buffer[i * 4] << 24) |
-               (buffer[i * 4 + 1] << 16) |
-               (buffer[i * 4 + 2] << 8) |
-               (buffer[i * 4 + 3]);
-    }
-
-    // extend 16 words to 80
-    for (size_t i = 16; i < 80; ++i) {
-        w[i] = leftRotate(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        w[i] = (static_cast<uint32_t>(block[i * 4]) << 24) |
+               (block[i * 4 + 1] << 16) |
+               (block[i * 4 + 2] << 8) |
+               (block[i * 4 + 3]);
     }
 
     // initialize variables
@@ -91,31 +139,93 @@ void SHA1::processBlock() {
     uint32_t d = state[3];
     uint32_t e = state[4];
 
-    // main loop
-    for (size_t i = 0; i < 80; ++i) {
-        uint32_t f, k;
-
-        if (i < 20) {
-            f = (b & c) | (~b & d);
-            k = 0x5A827999;
-        } else if (i < 40) {
-            f = b ^ c ^ d;
-            k = 0x6ED9EBA1;
-        } else if (i < 60) {
-            f = (b & c) | (b & d) | (c & d);
-            k = 0x8F1BBCDC;
-        } else {
-            f = b ^ c ^ d;
-            k = 0xCA62C1D6;
-        }
+    // rounds 0-19, unrolled so variables rotate roles instead of being shifted
+    sha1Round1(a, b, c, d, e, w[0]);
+    sha1Round1(e, a, b, c, d, w[1]);
+    sha1Round1(d, e, a, b, c, w[2]);
+    sha1Round1(c, d, e, a, b, w[3]);
+    sha1Round1(b, c, d, e, a, w[4]);
+    sha1Round1(a, b, c, d, e, w[5]);
+    sha1Round1(e, a, b, c, d, w[6]);
+    sha1Round1(d, e, a, b, c, w[7]);
+    sha1Round1(c, d, e, a, b, w[8]);
+    sha1Round1(b, c, d, e, a, w[9]);
+    sha1Round1(a, b, c, d, e, w[10]);
+    sha1Round1(e, a, b, c, d, w[11]);
+    sha1Round1(d, e, a, b, c, w[12]);
+    sha1Round1(c, d, e, a, b, w[13]);
+    sha1Round1(b, c, d, e, a, w[14]);
+    sha1Round1(a, b, c, d, e, w[15]);
+    sha1Round1(e, a, b, c, d, sha1Expand(w, 0));
+    sha1Round1(d, e, a, b, c, sha1Expand(w, 1));
+    sha1Round1(c, d, e, a, b, sha1Expand(w, 2));
+    sha1Round1(b, c, d, e, a, sha1Expand(w, 3));
 
-        uint32_t temp = leftRotate(a, 5) + f + e + k + w[i];
-        e = d;
-        d = c;
-        c = leftRotate(b, 30);
-        b = a;
-        a = temp;
-    }
+    // rounds 20-39
+    sha1Round2(a, b, c, d, e, sha1Expand(w, 4));
+    sha1Round2(e, a, b, c, d, sha1Expand(w, 5));
+    sha1Round2(d, e, a, b, c, sha1Expand(w, 6));
+    sha1Round2(c, d, e, a, b, sha1Expand(w, 7));
+    sha1Round2(b, c, d, e, a, sha1Expand(w, 8));
+    sha1Round2(a, b, c, d, e, sha1Expand(w, 9));
+    sha1Round2(e, a, b, c, d, sha1Expand(w, 10));
+    sha1Round2(d, e, a, b, c, sha1Expand(w, 11));
+    sha1Round2(c, d, e, a, b, sha1Expand(w, 12));
+    sha1Round2(b, c, d, e, a, sha1Expand(w, 13));
+    sha1Round2(a, b, c, d, e, sha1Expand(w, 14));
+    sha1Round2(e, a, b, c, d, sha1Expand(w, 15));
+    sha1Round2(d, e, a, b, c, sha1Expand(w, 0));
+    sha1Round2(c, d, e, a, b, sha1Expand(w, 1));
+    sha1Round2(b, c, d, e, a, sha1Expand(w, 2));
+    sha1Round2(a, b, c, d, e, sha1Expand(w, 3));
+    sha1Round2(e, a, b, c, d, sha1Expand(w, 4));
+    sha1Round2(d, e, a, b, c, sha1Expand(w, 5));
+    sha1Round2(c, d, e, a, b, sha1Expand(w, 6));
+    sha1Round2(b, c, d, e, a, sha1Expand(w, 7));
+
+    // rounds 40-59
+    sha1Round3(a, b, c, d, e, sha1Expand(w, 8));
+    sha1Round3(e, a, b, c, d, sha1Expand(w, 9));
+    sha1Round3(d, e, a, b, c, sha1Expand(w, 10));
+    sha1Round3(c, d, e, a, b, sha1Expand(w, 11));
+    sha1Round3(b, c, d, e, a, sha1Expand(w, 12));
+    sha1Round3(a, b, c, d, e, sha1Expand(w, 13));
+    sha1Round3(e, a, b, c, d, sha1Expand(w, 14));
+    sha1Round3(d, e, a, b, c, sha1Expand(w, 15));
+    sha1Round3(c, d, e, a, b, sha1Expand(w, 0));
+    sha1Round3(b, c, d, e, a, sha1Expand(w, 1));
+    sha1Round3(a, b, c, d, e, sha1Expand(w, 2));
+    sha1Round3(e, a, b, c, d, sha1Expand(w, 3));
+    sha1Round3(d, e, a, b, c, sha1Expand(w, 4));
+    sha1Round3(c, d, e, a, b, sha1Expand(w, 5));
+    sha1Round3(b, c, d, e, a, sha1Expand(w, 6));
+    sha1Round3(a, b, c, d, e, sha1Expand(w, 7));
+    sha1Round3(e, a, b, c, d, sha1Expand(w, 8));
+    sha1Round3(d, e, a, b, c, sha1Expand(w, 9));
+    sha1Round3(c, d, e, a, b, sha1Expand(w, 10));
+    sha1Round3(b, c, d, e, a, sha1Expand(w, 11));
+
+    // rounds 60-79
+    sha1Round4(a, b, c, d, e, sha1Expand(w, 12));
+    sha1Round4(e, a, b, c, d, sha1Expand(w, 13));
+    sha1Round4(d, e, a, b, c, sha1Expand(w, 14));
+    sha1Round4(c, d, e, a, b, sha1Expand(w, 15));
+    sha1Round4(b, c, d, e, a, sha1Expand(w, 0));
+    sha1Round4(a, b, c, d, e, sha1Expand(w, 1));
+    sha1Round4(e, a, b, c, d, sha1Expand(w, 2));
+    sha1Round4(d, e, a, b, c, sha1Expand(w, 3));
+    sha1Round4(c, d, e, a, b, sha1Expand(w, 4));
+    sha1Round4(b, c, d, e, a, sha1Expand(w, 5));
+    sha1Round4(a, b, c, d, e, sha1Expand(w, 6));
+    sha1Round4(e, a, b, c, d, sha1Expand(w, 7));
+    sha1Round4(d, e, a, b, c, sha1Expand(w, 8));
+    sha1Round4(c, d, e, a, b, sha1Expand(w, 9));
+    sha1Round4(b, c, d, e, a, sha1Expand(w, 10));
+    sha1Round4(a, b, c, d, e, sha1Expand(w, 11));
+    sha1Round4(e, a, b, c, d, sha1Expand(w, 12));
+    sha1Round4(d, e, a, b, c, sha1Expand(w, 13));
+    sha1Round4(c, d, e, a, b, sha1Expand(w, 14));
+    sha1Round4(b, c, d, e, a, sha1Expand(w, 15));
 
     // add variables to state
     state[0] += a;
@@ -123,25 +233,35 @@ void SHA1::processBlock() {
     state[2] += c;
     state[3] += d;
     state[4] += e;
-
-    // clear buffer
-    bufferIndex = 0;
-    std::memset(buffer, 0, BlockSize);
 }
 
 // finalize hash
 std::string SHA1::final() {
-    padBuffer(); // add padding
-    processBlock(); // process block
+    uint8_t digest[OutputSize];
+    final(digest);
 
-    // format state as hex
+    // format digest as hex
     std::ostringstream result;
+    for (uint8_t byte : digest) {
+        result << std::hex << std::setfill('0') << std::setw(2) << static_cast<int>(byte);
+    }
+    return result.str();
+}
+
+// finalize binary hash
+void SHA1::final(uint8_t digest[OutputSize]) {
+    padBuffer(); // add padding
+    processBlock(buffer); // process block
+
+    // store state as big-endian
     for (size_t i = 0; i < 5; ++i) {
-        result << std::hex << std::setfill('0') << std::setw(8) << state[i];
+        digest[i * 4] = static_cast<uint8_t>(state[i] >> 24);
+        digest[i * 4 + 1] = static_cast<uint8_t>(state[i] >> 16);
+        digest[i * 4 + 2] = static_cast<uint8_t>(state[i] >> 8);
+        digest[i * 4 + 3] = static_cast<uint8_t>(state[i]);
     }
 
     reset(); // reset state
-    return result.str();
 }
 
 // compute hash
@@ -150,3 +270,13 @@ std::string SHA1::hash(const std::string& input) {
     sha1.update(input);
     return sha1.final();
 }
+
+// write streaming state
+void SHA1::saveState(HashStateWriter& writer) const {
+    saveBlockState(writer, state, bitCount, buffer, bufferIndex);
+}
+
+// restore streaming state
+void SHA1::loadState(HashStateReader& reader) {
+    loadBlockState(reader, state, bitCount, buffer, bufferIndex, BlockSize);
+}
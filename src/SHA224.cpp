@@ -1,7 +1,9 @@
 #include "SHA224.h"
+#include "HashState.h"
 #include <iomanip>
 #include <sstream>
 #include <cstring>
+#include <algorithm>
 #include <array>
 #include <cstdint>
 
@@ -81,17 +83,42 @@ uint32_t SHA224::gamma1(uint32_t x) {
 
 // update hash state
 void SHA224::update(const std::string& data) {
-    const uint8_t* input = reinterpret_cast<const uint8_t*>(data.data());
-    size_t length = data.size();
-
-    for (size_t i = 0; i < length; ++i) {
-        buffer[bufferIndex++] = input[i];
-        bitCount += 8; // increment 8 bits per byte
+    update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+}
 
-        if (bufferIndex == BlockSize) { // full buffer
-            processBlock(buffer);
-            bufferIndex = 0;
+// update hash state with raw bytes
+void SHA224::update(const uint8_t* input, size_t length) {
+    if (length == 0) {
+        return;
+    }
+    bitCount += static_cast<uint64_t>(length) * 8;
+
+    // complete a partially filled buffer first
+    if (bufferIndex > 0) {
+        size_t take = std::min(length, BlockSize - bufferIndex);
+        std::memcpy(buffer + bufferIndex, input, take);
+        bufferIndex += take;
+        input += take;
+        length -= take;
+
+        if (bufferIndex < BlockSize) {
+            return;
         }
+        processBlock(buffer);
+        bufferIndex = 0;
+    }
+
+    // process full blocks straight from the input
+    while (length >= BlockSize) {
+        processBlock(input);
+        input += BlockSize;
+        length -= BlockSize;
+    }
+
+    // keep the tail for the next call
+    if (length > 0) {
+        std::memcpy(buffer, input, length);
+        bufferIndex = length;
     }
 }
 
@@ -127,7 +154,7 @@ void SHA224::processBlock(const uint8_t block[BlockSize]) {
 
     // load first 16 words of W
     for (int t = 0; t < 16; ++t) {
-        W[t] = (block[t * 4] << 24) |
+        W[t] = (static_cast<uint32_t>(block[t * 4]) << 24) |
                (block[t * 4 + 1] << 16) |
                (block[t * 4 + 2] << 8) |
                (block[t * 4 + 3]);
@@ -170,19 +197,45 @@ void SHA224::processBlock(const uint8_t block[BlockSize]) {
 
 // finaliz hash
 std::string SHA224::final() {
-    padBuffer();
+    uint8_t digest[OutputSize];
+    final(digest);
 
-    // convert state to string (first 7 words)
+    // convert digest to string
     std::ostringstream result;
-    for (size_t i = 0; i < 7; ++i) { 
-        result << std::hex << std::setfill('0') << std::setw(8) << state[i];
+    for (uint8_t byte : digest) {
+        result << std::hex << std::setfill('0') << std::setw(2) << static_cast<int>(byte);
     }
     return result.str();
 }
 
+// finalize binary hash
+void SHA224::final(uint8_t digest[OutputSize]) {
+    padBuffer();
+
+    // store first 7 words as big-endian
+    for (size_t i = 0; i < 7; ++i) {
+        digest[i * 4] = static_cast<uint8_t>(state[i] >> 24);
+        digest[i * 4 + 1] = static_cast<uint8_t>(state[i] >> 16);
+        digest[i * 4 + 2] = static_cast<uint8_t>(state[i] >> 8);
+        digest[i * 4 + 3] = static_cast<uint8_t>(state[i]);
+    }
+
+    reset(); // reset state
+}
+
 // calculate hash
 std::string SHA224::hash(const std::string& input) {
     SHA224 sha224;
     sha224.update(input);
     return sha224.final();
 }
+
+// write streaming state
+void SHA224::saveState(HashStateWriter& writer) const {
+    saveBlockState(writer, state, bitCount, buffer, bufferIndex);
+}
+
+// restore streaming state
+void SHA224::loadState(HashStateReader& reader) {
+    loadBlockState(reader, state, bitCount, buffer, bufferIndex, BlockSize);
+}
@@ -1,8 +1,56 @@
 #include "SHA256.h"
+#include "HashState.h"
 #include <vector>
 #include <sstream>
 #include <iomanip>
 #include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <array>
+
+// initial hash values
+static constexpr uint32_t InitialState[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+// rotate right for compile time schedules
+static constexpr uint32_t rotr(uint32_t x, uint32_t n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+// expanded message schedule of a block holding only padding for a message of bits length
+static constexpr std::array<uint32_t, 64> paddingSchedule(uint64_t bits) {
+    std::array<uint32_t, 64> W{};
+    W[0] = 0x80000000;
+    W[14] = static_cast<uint32_t>(bits >> 32);
+    W[15] = static_cast<uint32_t>(bits);
+    for (size_t i = 16; i < 64; ++i) {
+        uint32_t s0 = rotr(W[i - 15], 7) ^ rotr(W[i - 15], 18) ^ (W[i - 15] >> 3);
+        uint32_t s1 = rotr(W[i - 2], 17) ^ rotr(W[i - 2], 19) ^ (W[i - 2] >> 10);
+        W[i] = s1 + W[i - 7] + s0 + W[i - 16];
+    }
+    return W;
+}
+
+// second block of every 64 byte message, expanded at compile time
+static constexpr std::array<uint32_t, 64> Padding64 = paddingSchedule(512);
+
+// load big-endian word
+static uint32_t loadWord(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+// store hash values as big-endian
+static void storeDigest(const uint32_t state[8], uint8_t* digest) {
+    for (size_t i = 0; i < 8; ++i) {
+        digest[i * 4] = static_cast<uint8_t>(state[i] >> 24);
+        digest[i * 4 + 1] = static_cast<uint8_t>(state[i] >> 16);
+        digest[i * 4 + 2] = static_cast<uint8_t>(state[i] >> 8);
+        digest[i * 4 + 3] = static_cast<uint8_t>(state[i]);
+    }
+}
 
 // constants
 const uint32_t SHA256::K[64] = {
@@ -59,40 +107,100 @@ uint32_t SHA256::smallSigma1(uint32_t x) {
     return rotateRight(x, 17) ^ rotateRight(x, 19) ^ (x >> 10);
 }
 
-// pad data
-std::vector<uint8_t> SHA256::paddata(const std::string& data) {
-    std::vector<uint8_t> padded(data.begin(), data.end());
-    size_t originalSize = padded.size() * 8; // original size
+// sha256 constructor
+SHA256::SHA256() {
+    reset();
+}
+
+// reset object state
+void SHA256::reset() {
+    std::memcpy(state, InitialState, sizeof(state));
+
+    bitCount = 0;
+    bufferIndex = 0;
+}
+
+// update state
+void SHA256::update(const std::string& data) {
+    update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+}
+
+// update state with raw bytes
+void SHA256::update(const uint8_t* data, size_t length) {
+    if (length == 0) {
+        return;
+    }
+    bitCount += static_cast<uint64_t>(length) * 8;
+
+    // complete a partially filled buffer first
+    if (bufferIndex > 0) {
+        size_t take = std::min(length, BlockSize - bufferIndex);
+        std::memcpy(buffer + bufferIndex, data, take);
+        bufferIndex += take;
+        data += take;
+        length -= take;
+
+        if (bufferIndex < BlockSize) {
+            return;
+        }
+        processBlock(buffer, state);
+        bufferIndex = 0;
+    }
+
+    // process full blocks straight from the input
+    while (length >= BlockSize) {
+        processBlock(data, state);
+        data += BlockSize;
+        length -= BlockSize;
+    }
+
+    // keep the tail for the next call
+    if (length > 0) {
+        std::memcpy(buffer, data, length);
+        bufferIndex = length;
+    }
+}
 
-    // Append a '1'
-    padded.push_back(0x80);
+// pad buffer and process last block
+void SHA256::padBuffer() {
+    buffer[bufferIndex++] = 0x80; // append '1'
 
-    // add 0's until size congruent to 448 mod 512
-    while ((padded.size() * 8) % 512 != 448) {
-        padded.push_back(0x00);
+    // process block if no room for the length
+    if (bufferIndex > BlockSize - 8) {
+        std::memset(buffer + bufferIndex, 0, BlockSize - bufferIndex);
+        processBlock(buffer, state);
+        bufferIndex = 0;
     }
 
+    // add 0's until 8 bytes are left
+    std::memset(buffer + bufferIndex, 0, BlockSize - 8 - bufferIndex);
+
     // append original size as big-endian
     for (int i = 7; i >= 0; --i) {
-        padded.push_back(static_cast<uint8_t>((originalSize >> (i * 8)) & 0xFF));
+        buffer[BlockSize - 1 - i] = static_cast<uint8_t>(bitCount >> (i * 8));
     }
-
-    return padded;
+    processBlock(buffer, state);
 }
 
 // process block
-void SHA256::processBlock(const std::vector<uint8_t>& block, uint32_t hashValues[8]) {
+void SHA256::processBlock(const uint8_t* block, uint32_t hashValues[8]) {
     uint32_t W[64]; // data schedule array
     for (size_t i = 0; i < 16; ++i) {
-        W[i] = (block[i * 4] << 24) | (block[i * 4 + 1] << 16) |
-               (block[i * 4 + 2] << 8) | block[i * 4 + 3];
+        W[i] = loadWord(block + i * 4);
     }
+    expandSchedule(W);
+    compress(W, hashValues);
+}
 
-    // extend 16 words into last 48
+// extend 16 words into last 48
+void SHA256::expandSchedule(uint32_t W[64]) {
     for (size_t i = 16; i < 64; ++i) {
         W[i] = smallSigma1(W[i - 2]) + W[i - 7] + smallSigma0(W[i - 15]) + W[i - 16];
     }
+}
 
+// run rounds over an expanded schedule
+void SHA256::compress(const uint32_t W[64], uint32_t hashValues[8]) {
     // initialize variables
     uint32_t a = hashValues[0];
     uint32_t b = hashValues[1];
@@ -128,28 +236,90 @@ void SHA256::processBlock(const std::vector<uint8_t>& block, uint32_t hashValues
     hashValues[7] += h;
 }
 
-// compute hash
-std::string SHA256::hash(const std::string& data) {
-    // initialize hash values
-    uint32_t hashValues[8] = {
-        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
-        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
-    };
-
-    // pad data
-    std::vector<uint8_t> paddeddata = paddata(data);
-
-    // process block
-    for (size_t i = 0; i < paddeddata.size(); i += 64) {
-        std::vector<uint8_t> block(paddeddata.begin() + i, paddeddata.begin() + i + 64);
-        processBlock(block, hashValues);
-    }
+// finalize hash
+std::string SHA256::final() {
+    uint8_t digest[OutputSize];
+    final(digest);
 
     // format hash as hex
     std::ostringstream result;
-    for (uint32_t h : hashValues) {
-        result << std::hex << std::setw(8) << std::setfill('0') << h;
+    for (uint8_t byte : digest) {
+        result << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(byte);
     }
 
     return result.str();
 }
+
+// finalize binary hash
+void SHA256::final(uint8_t digest[OutputSize]) {
+    padBuffer();
+    storeDigest(state, digest);
+    reset(); // reset state
+}
+
+// compute binary hash
+void SHA256::hash(const uint8_t* data, size_t length, uint8_t digest[OutputSize]) {
+    // digests and node pairs skip the generic padding path
+    if (length == 32) {
+        hash32(data, digest);
+        return;
+    }
+    if (length == 64) {
+        hash64(data, digest);
+        return;
+    }
+
+    SHA256 sha256;
+    sha256.update(data, length);
+    sha256.final(digest);
+}
+
+// compute hash
+std::string SHA256::hash(const std::string& data) {
+    SHA256 sha256;
+    sha256.update(data);
+    return sha256.final();
+}
+
+// hash 32 bytes, the padding fills the second half of the only block
+void SHA256::hash32(const uint8_t data[32], uint8_t digest[OutputSize]) {
+    uint32_t W[64];
+    for (size_t i = 0; i < 8; ++i) {
+        W[i] = loadWord(data + i * 4);
+    }
+    W[8] = 0x80000000;
+    std::memset(W + 9, 0, 6 * sizeof(uint32_t));
+    W[15] = 256;
+    expandSchedule(W);
+
+    uint32_t hashValues[8];
+    std::memcpy(hashValues, InitialState, sizeof(hashValues));
+    compress(W, hashValues);
+    storeDigest(hashValues, digest);
+}
+
+// hash 64 bytes, the padding block schedule is precomputed
+void SHA256::hash64(const uint8_t data[64], uint8_t digest[OutputSize]) {
+    uint32_t hashValues[8];
+    std::memcpy(hashValues, InitialState, sizeof(hashValues));
+    processBlock(data, hashValues);
+    compress(Padding64.data(), hashValues);
+    storeDigest(hashValues, digest);
+}
+
+// hash twice, the second pass always takes the 32 byte kernel
+void SHA256::hash256d(const uint8_t* data, size_t length, uint8_t digest[OutputSize]) {
+    uint8_t first[OutputSize];
+    hash(data, length, first);
+    hash32(first, digest);
+}
+
+// write streaming state
+void SHA256::saveState(HashStateWriter& writer) const {
+    saveBlockState(writer, state, bitCount, buffer, bufferIndex);
+}
+
+// restore streaming state
+void SHA256::loadState(HashStateReader& reader) {
+    loadBlockState(reader, state, bitCount, buffer, bufferIndex, BlockSize);
+}
@@ -0,0 +1,81 @@
+#include "SHA3.h"
+#include <iomanip> // Formatting
+#include <sstream> // String stream
+#include <stdexcept> // Error handling
+#include <vector>
+
+// check digest size
+static size_t checkedOutputSize(size_t outputSize) {
+    if (outputSize != SHA3::OutputSize224 && outputSize != SHA3::OutputSize256 &&
+        outputSize != SHA3::OutputSize384 && outputSize != SHA3::OutputSize512) {
+        throw std::runtime_error("Unsupported SHA-3 digest size");
+    }
+    return outputSize;
+}
+
+// constructor, domain bits 01 then the first padding bit
+SHA3::SHA3(size_t outputSize) : size(checkedOutputSize(outputSize)), sponge(200 - 2 * outputSize, 0x06) {}
+
+// update hash
+void SHA3::update(const std::string& data) {
+    update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+}
+
+// update hash with raw bytes
+void SHA3::update(const uint8_t* data, size_t length) {
+    sponge.absorb(data, length);
+}
+
+// finalize hash
+std::string SHA3::final() {
+    std::vector<uint8_t> digest(size);
+    final(digest.data());
+
+    // format hash as hex
+    std::ostringstream result;
+    for (uint8_t byte : digest) {
+        result << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(byte);
+    }
+
+    return result.str();
+}
+
+// finalize binary hash
+void SHA3::final(uint8_t* digest) {
+    sponge.squeeze(digest, size);
+    reset(); // reset state
+}
+
+// reset state
+void SHA3::reset() {
+    sponge.reset();
+}
+
+// digest size
+size_t SHA3::outputSize() const {
+    return size;
+}
+
+// compute binary hash
+void SHA3::hash(const uint8_t* data, size_t length, uint8_t* digest, size_t outputSize) {
+    SHA3 sha3(outputSize);
+    sha3.update(data, length);
+    sha3.final(digest);
+}
+
+// compute hash
+std::string SHA3::hash(const std::string& data, size_t outputSize) {
+    SHA3 sha3(outputSize);
+    sha3.update(data);
+    return sha3.final();
+}
+
+// write streaming state
+void SHA3::saveState(HashStateWriter& writer) const {
+    sponge.saveState(writer);
+}
+
+// restore streaming state, the rate check rejects a state of another digest size
+void SHA3::loadState(HashStateReader& reader) {
+    sponge.loadState(reader);
+}
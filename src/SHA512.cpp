@@ -1,7 +1,9 @@
 #include "SHA512.h"
+#include "HashState.h"
 #include <vector>
 #include <cstdint>
 #include <cstring>
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 
@@ -68,87 +70,183 @@ uint64_t SHA512::Sigma1(uint64_t x) {
     return ROTR(x, 14) ^ ROTR(x, 18) ^ ROTR(x, 41); // uppercase (sigma1)
 }
 
-// data padding
-std::vector<uint8_t> SHA512::paddata(const std::string &data) {
-    uint64_t dataBits = data.size() * 8; // data length
-    std::vector<uint8_t> padded(data.begin(), data.end());
+// sha512 constructor
+SHA512::SHA512() : SHA512(H0) {}
 
-    padded.push_back(0x80); // append 1 bit
-    while ((padded.size() + 8) % 128 != 0) {
-        padded.push_back(0x00); // append 0 bit, align with 128 byte boundry
+// constructor with initial hash values
+SHA512::SHA512(const uint64_t initial[8]) : initial(initial) {
+    reset();
+}
+
+// reset state to initial values
+void SHA512::reset() {
+    std::memcpy(state, initial, sizeof(state));
+    bitCount = 0;
+    bufferIndex = 0;
+}
+
+// update state
+void SHA512::update(const std::string& data) {
+    update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+}
+
+// update state with raw bytes
+void SHA512::update(const uint8_t* data, size_t length) {
+    if (length == 0) {
+        return;
+    }
+    bitCount += static_cast<uint64_t>(length) * 8;
+
+    // complete a partially filled buffer first
+    if (bufferIndex > 0) {
+        size_t take = std::min(length, BlockSize - bufferIndex);
+        std::memcpy(buffer + bufferIndex, data, take);
+        bufferIndex += take;
+        data += take;
+        length -= take;
+
+        if (bufferIndex < BlockSize) {
+            return;
+        }
+        processBlock(buffer, state);
+        bufferIndex = 0;
     }
 
-    // append data as big endian
-    for (int i = 7; i >= 0; --i) {
-        padded.push_back((dataBits >> (i * 8)) & 0xff);
+    // process full blocks straight from the input
+    while (length >= BlockSize) {
+        processBlock(data, state);
+        data += BlockSize;
+        length -= BlockSize;
     }
 
-    return padded;
+    // keep the tail for the next call
+    if (length > 0) {
+        std::memcpy(buffer, data, length);
+        bufferIndex = length;
+    }
 }
 
-// main hashing
-std::string SHA512::hash(const std::string &data) {
-    // initialize variables
-    uint64_t H[8];
-    std::memcpy(H, H0, sizeof(H0));
-
-    // pad data
-    std::vector<uint8_t> paddeddata = paddata(data);
-
-    // process chunks
-    for (size_t chunk = 0; chunk < paddeddata.size(); chunk += 128) {
-        uint64_t W[80] = {0}; // schedule array
-
-        // load chunk into first 16 words
-        for (int i = 0; i < 16; ++i) {
-            W[i] = (static_cast<uint64_t>(paddeddata[chunk + i * 8]) << 56) |
-                   (static_cast<uint64_t>(paddeddata[chunk + i * 8 + 1]) << 48) |
-                   (static_cast<uint64_t>(paddeddata[chunk + i * 8 + 2]) << 40) |
-                   (static_cast<uint64_t>(paddeddata[chunk + i * 8 + 3]) << 32) |
-                   (static_cast<uint64_t>(paddeddata[chunk + i * 8 + 4]) << 24) |
-                   (static_cast<uint64_t>(paddeddata[chunk + i * 8 + 5]) << 16) |
-                   (static_cast<uint64_t>(paddeddata[chunk + i * 8 + 6]) << 8) |
-                   static_cast<uint64_t>(paddeddata[chunk + i * 8 + 7]);
-        }
+// pad buffer to multiple of 1024 bits with a 128 bit length
+void SHA512::padBuffer() {
+    buffer[bufferIndex++] = 0x80; // append 1 bit
 
-        // extend 16 into remaining 64
-        for (int i = 16; i < 80; ++i) {
-            W[i] = sigma1(W[i - 2]) + W[i - 7] + sigma0(W[i - 15]) + W[i - 16];
-        }
+    // process block if no room for the length
+    if (bufferIndex > BlockSize - 16) {
+        std::memset(buffer + bufferIndex, 0, BlockSize - bufferIndex);
+        processBlock(buffer, state);
+        bufferIndex = 0;
+    }
 
-        // initialize variables for chunk
-        uint64_t a = H[0], b = H[1], c = H[2], d = H[3];
-        uint64_t e = H[4], f = H[5], g = H[6], h = H[7];
-
-        // main loop
-        for (int i = 0; i < 80; ++i) {
-            uint64_t T1 = h + Sigma1(e) + Ch(e, f, g) + K[i] + W[i];
-            uint64_t T2 = Sigma0(a) + Maj(a, b, c);
-            h = g;
-            g = f;
-            f = e;
-            e = d + T1;
-            d = c;
-            c = b;
-            b = a;
-            a = T1 + T2;
-        }
+    // append 0's, high 64 bits of the length are always zero here
+    std::memset(buffer + bufferIndex, 0, BlockSize - 8 - bufferIndex);
+
+    // append original size as big endian
+    for (int i = 7; i >= 0; --i) {
+        buffer[BlockSize - 1 - i] = static_cast<uint8_t>(bitCount >> (i * 8));
+    }
+    processBlock(buffer, state);
+}
+
+// process block
+void SHA512::processBlock(const uint8_t* block, uint64_t* H) {
+    uint64_t W[80]; // schedule array
+
+    // load block into first 16 words
+    for (int i = 0; i < 16; ++i) {
+        W[i] = (static_cast<uint64_t>(block[i * 8]) << 56) |
+               (static_cast<uint64_t>(block[i * 8 + 1]) << 48) |
+               (static_cast<uint64_t>(block[i * 8 + 2]) << 40) |
+               (static_cast<uint64_t>(block[i * 8 + 3]) << 32) |
+               (static_cast<uint64_t>(block[i * 8 + 4]) << 24) |
+               (static_cast<uint64_t>(block[i * 8 + 5]) << 16) |
+               (static_cast<uint64_t>(block[i * 8 + 6]) << 8) |
+               static_cast<uint64_t>(block[i * 8 + 7]);
+    }
 
-        // update hash values
-        H[0] += a;
-        H[1] += b;
-        H[2] += c;
-        H[3] += d;
-        H[4] += e;
-        H[5] += f;
-        H[6] += g;
-        H[7] += h;
+    // extend 16 into remaining 64
+    for (int i = 16; i < 80; ++i) {
+        W[i] = sigma1(W[i - 2]) + W[i - 7] + sigma0(W[i - 15]) + W[i - 16];
     }
 
-    // finalize hash
+    // initialize variables for block
+    uint64_t a = H[0], b = H[1], c = H[2], d = H[3];
+    uint64_t e = H[4], f = H[5], g = H[6], h = H[7];
+
+    // main loop
+    for (int i = 0; i < 80; ++i) {
+        uint64_t T1 = h + Sigma1(e) + Ch(e, f, g) + K[i] + W[i];
+        uint64_t T2 = Sigma0(a) + Maj(a, b, c);
+        h = g;
+        g = f;
+        f = e;
+        e = d + T1;
+        d = c;
+        c = b;
+        b = a;
+        a = T1 + T2;
+    }
+
+    // update hash values
+    H[0] += a;
+    H[1] += b;
+    H[2] += c;
+    H[3] += d;
+    H[4] += e;
+    H[5] += f;
+    H[6] += g;
+    H[7] += h;
+}
+
+// finalize hash
+std::string SHA512::final() {
+    uint8_t digest[OutputSize];
+    final(digest);
+
+    // format hash as hex
     std::ostringstream hash;
-    for (int i = 0; i < 8; ++i) {
-        hash << std::hex << std::setw(16) << std::setfill('0') << H[i];
+    for (uint8_t byte : digest) {
+        hash << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(byte);
     }
     return hash.str();
 }
+
+// finalize binary hash
+void SHA512::final(uint8_t digest[OutputSize]) {
+    finish(digest, OutputSize);
+}
+
+// finalize truncated binary hash
+void SHA512::finish(uint8_t* digest, size_t length) {
+    padBuffer();
+
+    // finalize hash as big-endian
+    for (size_t i = 0; i < length; ++i) {
+        digest[i] = static_cast<uint8_t>(state[i / 8] >> (56 - (i % 8) * 8));
+    }
+
+    reset(); // reset state
+}
+
+// main hashing
+void SHA512::hash(const uint8_t* data, size_t length, uint8_t digest[OutputSize]) {
+    SHA512 sha512;
+    sha512.update(data, length);
+    sha512.final(digest);
+}
+
+// hash string
+std::string SHA512::hash(const std::string &data) {
+    SHA512 sha512;
+    sha512.update(data);
+    return sha512.final();
+}
+
+// write streaming state
+void SHA512::saveState(HashStateWriter& writer) const {
+    saveBlockState(writer, state, bitCount, buffer, bufferIndex);
+}
+
+// restore streaming state
+void SHA512::loadState(HashStateReader& reader) {
+    loadBlockState(reader, state, bitCount, buffer, bufferIndex, BlockSize);
+}
@@ -0,0 +1,44 @@
+#include "SHA512_224.h"
+#include <iomanip>
+#include <sstream>
+
+// initial hash values, generated by the SHA-512/t IV function for t = 224
+static const uint64_t InitialHash[8] = {
+    0x8c3d37c819544da2ULL, 0x73e1996689dcd4d6ULL, 0x1dfab7ae32ff9c82ULL, 0x679dd514582f9fcfULL,
+    0x0f6d2b697bd44da8ULL, 0x77e36f7304c48942ULL, 0x3f9d85a86a1d36c8ULL, 0x1112e6ad91d692a1ULL
+};
+
+// sha512/224 constructor
+SHA512_224::SHA512_224() : SHA512(InitialHash) {}
+
+// finalize hash
+std::string SHA512_224::final() {
+    uint8_t digest[OutputSize];
+    final(digest);
+
+    // format hash as hex
+    std::ostringstream hash;
+    for (uint8_t byte : digest) {
+        hash << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(byte);
+    }
+    return hash.str();
+}
+
+// finalize binary hash
+void SHA512_224::final(uint8_t digest[OutputSize]) {
+    finish(digest, OutputSize);
+}
+
+// main hashing
+void SHA512_224::hash(const uint8_t* data, size_t length, uint8_t digest[OutputSize]) {
+    SHA512_224 sha512;
+    sha512.update(data, length);
+    sha512.final(digest);
+}
+
+// hash string
+std::string SHA512_224::hash(const std::string& data) {
+    SHA512_224 sha512;
+    sha512.update(data);
+    return sha512.final();
+}
@@ -0,0 +1,44 @@
+#include "SHA512_256.h"
+#include <iomanip>
+#include <sstream>
+
+// initial hash values, generated by the SHA-512/t IV function for t = 256
+static const uint64_t InitialHash[8] = {
+    0x22312194fc2bf72cULL, 0x9f555fa3c84c64c2ULL, 0x2393b86b6f53b151ULL, 0x963877195940eabdULL,
+    0x96283ee2a88effe3ULL, 0xbe5e1e2553863992ULL, 0x2b0199fc2c85b8aaULL, 0x0eb72ddc81c52ca2ULL
+};
+
+// sha512/256 constructor
+SHA512_256::SHA512_256() : SHA512(InitialHash) {}
+
+// finalize hash
+std::string SHA512_256::final() {
+    uint8_t digest[OutputSize];
+    final(digest);
+
+    // format hash as hex
+    std::ostringstream hash;
+    for (uint8_t byte : digest) {
+        hash << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(byte);
+    }
+    return hash.str();
+}
+
+// finalize binary hash
+void SHA512_256::final(uint8_t digest[OutputSize]) {
+    finish(digest, OutputSize);
+}
+
+// main hashing
+void SHA512_256::hash(const uint8_t* data, size_t length, uint8_t digest[OutputSize]) {
+    SHA512_256 sha512;
+    sha512.update(data, length);
+    sha512.final(digest);
+}
+
+// hash string
+std::string SHA512_256::hash(const std::string& data) {
+    SHA512_256 sha512;
+    sha512.update(data);
+    return sha512.final();
+}
@@ -0,0 +1,86 @@
+#include "SHAKE.h"
+#include <iomanip> // Formatting
+#include <sstream> // String stream
+#include <stdexcept> // Error handling
+#include <vector>
+
+// check security level
+static size_t checkedSecurity(size_t securityBits) {
+    if (securityBits != 128 && securityBits != 256) {
+        throw std::runtime_error("Unsupported SHAKE security level");
+    }
+    return securityBits;
+}
+
+// constructor, domain bits 1111 then the first padding bit
+SHAKE::SHAKE(size_t securityBits)
+    : security(checkedSecurity(securityBits)), sponge(200 - securityBits / 4, 0x1f) {}
+
+// update hash
+void SHAKE::update(const std::string& data) {
+    update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+}
+
+// update hash with raw bytes
+void SHAKE::update(const uint8_t* data, size_t length) {
+    sponge.absorb(data, length);
+}
+
+// stream output
+void SHAKE::squeeze(uint8_t* output, size_t length) {
+    sponge.squeeze(output, length);
+}
+
+// finalize hash
+std::string SHAKE::final() {
+    std::vector<uint8_t> digest(outputSize());
+    final(digest.data());
+
+    // format hash as hex
+    std::ostringstream result;
+    for (uint8_t byte : digest) {
+        result << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(byte);
+    }
+
+    return result.str();
+}
+
+// finalize binary hash
+void SHAKE::final(uint8_t* digest) {
+    sponge.squeeze(digest, outputSize());
+    reset(); // reset state
+}
+
+// reset state
+void SHAKE::reset() {
+    sponge.reset();
+}
+
+// default output size
+size_t SHAKE::outputSize() const {
+    return security / 4;
+}
+
+// compute output
+void SHAKE::hash(const uint8_t* data, size_t length, uint8_t* output, size_t outputLength, size_t securityBits) {
+    SHAKE shake(securityBits);
+    shake.update(data, length);
+    shake.squeeze(output, outputLength);
+}
+
+// compute hash
+std::string SHAKE::hash(const std::string& data, size_t securityBits) {
+    SHAKE shake(securityBits);
+    shake.update(data);
+    return shake.final();
+}
+
+// write streaming state
+void SHAKE::saveState(HashStateWriter& writer) const {
+    sponge.saveState(writer);
+}
+
+// restore streaming state, the rate check rejects a state of the other security level
+void SHAKE::loadState(HashStateReader& reader) {
+    sponge.loadState(reader);
+}
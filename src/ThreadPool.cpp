@@ -0,0 +1,211 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <exception>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// pool and queue index of the current worker thread
+static thread_local ThreadPool* currentPool = nullptr;
+static thread_local size_t currentIndex = 0;
+
+// thread pool constructor
+ThreadPool::ThreadPool(const ThreadPoolOptions& options) : pending(0), stopping(false), nextQueue(0) {
+    size_t threads = options.threads;
+    if (threads == 0) {
+        threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    // create queues before any worker can steal from them
+    for (size_t i = 0; i < threads; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+
+    // start workers
+    for (size_t i = 0; i < threads; ++i) {
+        workers[i]->thread = std::thread(&ThreadPool::workerLoop, this, i);
+        if (!options.affinity.empty()) {
+            pinThread(workers[i]->thread, options.affinity[i % options.affinity.size()]);
+        }
+    }
+}
+
+// thread pool destructor
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (auto& worker : workers) {
+        worker->thread.join();
+    }
+}
+
+// number of workers
+size_t ThreadPool::size() const {
+    return workers.size();
+}
+
+// shared pool
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+// queue task
+void ThreadPool::submit(Task task) {
+    // workers push to their own queue, outside callers spread round robin
+    size_t index = currentPool == this ? currentIndex : nextQueue.fetch_add(1) % workers.size();
+
+    pending.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(workers[index]->mutex);
+        workers[index]->tasks.push_back(std::move(task));
+    }
+
+    // wake a sleeping worker
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wake.notify_one();
+}
+
+// take task from own queue or steal one
+bool ThreadPool::popTask(size_t index, Task& task) {
+    // newest task from own queue is most likely still in cache
+    {
+        Worker& own = *workers[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            pending.fetch_sub(1);
+            return true;
+        }
+    }
+
+    // steal oldest task from the other queues
+    for (size_t i = 1; i < workers.size(); ++i) {
+        Worker& victim = *workers[(index + i) % workers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            pending.fetch_sub(1);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// run one queued task on the calling thread
+bool ThreadPool::runPendingTask() {
+    Task task;
+    size_t index = currentPool == this ? currentIndex : nextQueue.load() % workers.size();
+    if (!popTask(index, task)) {
+        return false;
+    }
+    task();
+    return true;
+}
+
+// worker main loop
+void ThreadPool::workerLoop(size_t index) {
+    currentPool = this;
+    currentIndex = index;
+
+    for (;;) {
+        Task task;
+        if (popTask(index, task)) {
+            task();
+            continue;
+        }
+
+        // sleep until work arrives or pool stops
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return stopping.load() || pending.load() > 0; });
+        if (stopping.load() && pending.load() == 0) {
+            return;
+        }
+    }
+}
+
+// run body over ranges of [0, count)
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t begin, size_t end)>& body) {
+    if (count == 0) {
+        return;
+    }
+
+    // a few ranges per worker so stealing can even out uneven ranges
+    size_t ranges = std::min(count, workers.size() * 4);
+    if (ranges == 1) {
+        body(0, count);
+        return;
+    }
+
+    // completion state shared with the tasks
+    struct Group {
+        std::atomic<size_t> remaining;
+        std::mutex mutex;
+        std::condition_variable done;
+        std::exception_ptr error;
+    };
+    auto group = std::make_shared<Group>();
+    group->remaining = ranges;
+
+    // queue ranges
+    size_t step = count / ranges;
+    size_t extra = count % ranges;
+    size_t begin = 0;
+    for (size_t r = 0; r < ranges; ++r) {
+        size_t end = begin + step + (r < extra ? 1 : 0);
+        submit([group, &body, begin, end] {
+            try {
+                body(begin, end);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(group->mutex);
+                if (!group->error) {
+                    group->error = std::current_exception();
+                }
+            }
+
+            // last range wakes the caller
+            if (group->remaining.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(group->mutex);
+                group->done.notify_all();
+            }
+        });
+        begin = end;
+    }
+
+    // help until the queues are empty, then wait for ranges still running
+    while (group->remaining.load() > 0 && runPendingTask()) {
+    }
+    {
+        std::unique_lock<std::mutex> lock(group->mutex);
+        group->done.wait(lock, [&group] { return group->remaining.load() == 0; });
+    }
+
+    // report first failure to the caller
+    if (group->error) {
+        std::rethrow_exception(group->error);
+    }
+}
+
+// pin thread to cpu
+void ThreadPool::pinThread(std::thread& thread, int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#else
+    (void)thread; // affinity not supported on this platform
+    (void)cpu;
+#endif
+}
@@ -0,0 +1,51 @@
+#include "XXH128.h"
+#include <sstream>
+#include <iomanip>
+
+// store value as big-endian bytes, high half first
+static void storeValue(XXH128Value value, uint8_t digest[16]) {
+    for (size_t i = 0; i < 8; ++i) {
+        digest[i] = static_cast<uint8_t>(value.high >> (56 - 8 * i));
+        digest[i + 8] = static_cast<uint8_t>(value.low >> (56 - 8 * i));
+    }
+}
+
+// xxh128 constructor
+XXH128::XXH128(uint64_t seed) : XXH3(seed) {}
+
+// finalize value
+XXH128Value XXH128::finalValue() {
+    XXH128Value value = value128();
+    reset(); // reset state
+    return value;
+}
+
+// finalize binary hash
+void XXH128::final(uint8_t digest[OutputSize]) {
+    storeValue(finalValue(), digest);
+}
+
+// finalize hash
+std::string XXH128::final() {
+    XXH128Value value = finalValue();
+    std::ostringstream result;
+    result << std::hex << std::setfill('0') << std::setw(16) << value.high << std::setw(16) << value.low;
+    return result.str();
+}
+
+// compute hash value
+XXH128Value XXH128::hashValue(const uint8_t* data, size_t length, uint64_t seed) {
+    return oneShot128(data, length, seed);
+}
+
+// compute binary hash
+void XXH128::hash(const uint8_t* data, size_t length, uint8_t digest[OutputSize]) {
+    storeValue(oneShot128(data, length, 0), digest);
+}
+
+// compute hash
+std::string XXH128::hash(const std::string& data) {
+    XXH128 xxh128;
+    xxh128.update(data);
+    return xxh128.final();
+}
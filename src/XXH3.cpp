@@ -0,0 +1,689 @@
+#include "XXH3.h"
+#include "HashState.h"
+#include <sstream>
+#include <iomanip>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept> // Error handling
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define XXH3_SSE2 1
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define XXH3_AVX2 1
+#endif
+
+// primes
+static constexpr uint64_t Prime32_1 = 0x9E3779B1U;
+static constexpr uint64_t Prime32_2 = 0x85EBCA77U;
+static constexpr uint64_t Prime32_3 = 0xC2B2AE3DU;
+static constexpr uint64_t Prime64_1 = 0x9E3779B185EBCA87ULL;
+static constexpr uint64_t Prime64_2 = 0xC2B2AE3D27D4EB4FULL;
+static constexpr uint64_t Prime64_3 = 0x165667B19E3779F9ULL;
+static constexpr uint64_t Prime64_4 = 0x85EBCA77C2B2AE63ULL;
+static constexpr uint64_t Prime64_5 = 0x27D4EB2F165667C5ULL;
+static constexpr uint64_t PrimeMx1 = 0x165667919E3779F9ULL;
+static constexpr uint64_t PrimeMx2 = 0x9FB21C651E98DF25ULL;
+
+// default secret
+static constexpr uint8_t DefaultSecret[192] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+// secret offsets
+static constexpr size_t SecretSizeMin = 136;
+static constexpr size_t MidSizeStartOffset = 3;
+static constexpr size_t MidSizeLastOffset = 17;
+static constexpr size_t LastAccStart = 7;
+static constexpr size_t MergeAccsStart = 11;
+
+// load little-endian words
+static inline uint64_t read64(const uint8_t* p) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) {
+        value = (value << 8) | p[i];
+    }
+    return value;
+}
+
+static inline uint32_t read32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// store little-endian word
+static inline void write64(uint8_t* p, uint64_t value) {
+    for (size_t i = 0; i < 8; ++i) {
+        p[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+// byte swaps
+static inline uint32_t swap32(uint32_t x) {
+    return ((x << 24) & 0xff000000U) | ((x << 8) & 0x00ff0000U) | ((x >> 8) & 0x0000ff00U) | ((x >> 24) & 0x000000ffU);
+}
+
+static inline uint64_t swap64(uint64_t x) {
+    return (static_cast<uint64_t>(swap32(static_cast<uint32_t>(x))) << 32) | swap32(static_cast<uint32_t>(x >> 32));
+}
+
+// rotations
+static inline uint64_t rotl64(uint64_t x, int n) {
+    return (x << n) | (x >> (64 - n));
+}
+
+static inline uint32_t rotl32(uint32_t x, int n) {
+    return (x << n) | (x >> (32 - n));
+}
+
+// full 64x64 bit product
+static inline XXH128Value multiply(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    return {static_cast<uint64_t>(product), static_cast<uint64_t>(product >> 64)};
+#else
+    uint64_t loLo = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+    uint64_t hiLo = (a >> 32) * (b & 0xFFFFFFFF);
+    uint64_t loHi = (a & 0xFFFFFFFF) * (b >> 32);
+    uint64_t hiHi = (a >> 32) * (b >> 32);
+    uint64_t cross = (loLo >> 32) + (hiLo & 0xFFFFFFFF) + loHi;
+    uint64_t upper = (hiLo >> 32) + (cross >> 32) + hiHi;
+    uint64_t lower = (cross << 32) | (loLo & 0xFFFFFFFF);
+    return {lower, upper};
+#endif
+}
+
+// product folded to 64 bits
+static inline uint64_t multiplyFold(uint64_t a, uint64_t b) {
+    XXH128Value product = multiply(a, b);
+    return product.low ^ product.high;
+}
+
+// final mixes
+static inline uint64_t avalanche64(uint64_t h) {
+    h ^= h >> 33;
+    h *= Prime64_2;
+    h ^= h >> 29;
+    h *= Prime64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+static inline uint64_t avalanche(uint64_t h) {
+    h ^= h >> 37;
+    h *= PrimeMx1;
+    h ^= h >> 32;
+    return h;
+}
+
+static inline uint64_t rrmxmx(uint64_t h, uint64_t length) {
+    h ^= rotl64(h, 49) ^ rotl64(h, 24);
+    h *= PrimeMx2;
+    h ^= (h >> 35) + length;
+    h *= PrimeMx2;
+    h ^= h >> 28;
+    return h;
+}
+
+// mix 16 input bytes with 16 secret bytes
+static inline uint64_t mix16(const uint8_t* data, const uint8_t* secret, uint64_t seed) {
+    return multiplyFold(read64(data) ^ (read64(secret) + seed), read64(data + 8) ^ (read64(secret + 8) - seed));
+}
+
+// mix 32 input bytes into a 128-bit accumulator
+static inline XXH128Value mix32(XXH128Value acc, const uint8_t* first, const uint8_t* second,
+                                const uint8_t* secret, uint64_t seed) {
+    acc.low += mix16(first, secret, seed);
+    acc.low ^= read64(second) + read64(second + 8);
+    acc.high += mix16(second, secret + 16, seed);
+    acc.high ^= read64(first) + read64(first + 8);
+    return acc;
+}
+
+#ifdef XXH3_SSE2
+// accumulate stripes, secret advances 8 bytes per stripe, two lanes per register
+static void accumulateBaseline(uint64_t acc[8], const uint8_t* data, const uint8_t* secret, size_t stripes) {
+    __m128i lanes[4];
+    for (size_t i = 0; i < 4; ++i) {
+        lanes[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc) + i);
+    }
+    for (size_t n = 0; n < stripes; ++n) {
+        const __m128i* input = reinterpret_cast<const __m128i*>(data + n * 64);
+        const __m128i* key = reinterpret_cast<const __m128i*>(secret + n * 8);
+        for (size_t i = 0; i < 4; ++i) {
+            __m128i value = _mm_loadu_si128(input + i);
+            __m128i mixed = _mm_xor_si128(value, _mm_loadu_si128(key + i));
+            __m128i product = _mm_mul_epu32(mixed, _mm_shuffle_epi32(mixed, _MM_SHUFFLE(0, 3, 0, 1)));
+            __m128i swapped = _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+            lanes[i] = _mm_add_epi64(product, _mm_add_epi64(lanes[i], swapped));
+        }
+    }
+    for (size_t i = 0; i < 4; ++i) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(acc) + i, lanes[i]);
+    }
+}
+
+// scramble accumulators at the end of a block
+static void scrambleBaseline(uint64_t acc[8], const uint8_t* secret) {
+    const __m128i prime = _mm_set1_epi32(static_cast<int>(Prime32_1));
+    for (size_t i = 0; i < 4; ++i) {
+        __m128i lane = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc) + i);
+        lane = _mm_xor_si128(lane, _mm_srli_epi64(lane, 47));
+        lane = _mm_xor_si128(lane, _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i));
+        __m128i low = _mm_mul_epu32(lane, prime);
+        __m128i high = _mm_mul_epu32(_mm_shuffle_epi32(lane, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(acc) + i, _mm_add_epi64(low, _mm_slli_epi64(high, 32)));
+    }
+}
+#else
+// accumulate stripes, secret advances 8 bytes per stripe
+static void accumulateBaseline(uint64_t acc[8], const uint8_t* data, const uint8_t* secret, size_t stripes) {
+    for (size_t n = 0; n < stripes; ++n) {
+        for (size_t i = 0; i < 8; ++i) {
+            uint64_t value = read64(data + n * 64 + 8 * i);
+            uint64_t key = value ^ read64(secret + n * 8 + 8 * i);
+            acc[i ^ 1] += value;
+            acc[i] += (key & 0xFFFFFFFF) * (key >> 32);
+        }
+    }
+}
+
+// scramble accumulators at the end of a block
+static void scrambleBaseline(uint64_t acc[8], const uint8_t* secret) {
+    for (size_t i = 0; i < 8; ++i) {
+        uint64_t value = acc[i];
+        value ^= value >> 47;
+        value ^= read64(secret + 8 * i);
+        acc[i] = value * Prime32_1;
+    }
+}
+#endif
+
+#ifdef XXH3_AVX2
+// accumulate stripes with four lanes per register
+__attribute__((target("avx2")))
+static void accumulateAvx2(uint64_t acc[8], const uint8_t* data, const uint8_t* secret, size_t stripes) {
+    __m256i lanes[2];
+    for (size_t i = 0; i < 2; ++i) {
+        lanes[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc) + i);
+    }
+    for (size_t n = 0; n < stripes; ++n) {
+        const __m256i* input = reinterpret_cast<const __m256i*>(data + n * 64);
+        const __m256i* key = reinterpret_cast<const __m256i*>(secret + n * 8);
+        for (size_t i = 0; i < 2; ++i) {
+            __m256i value = _mm256_loadu_si256(input + i);
+            __m256i mixed = _mm256_xor_si256(value, _mm256_loadu_si256(key + i));
+            __m256i product = _mm256_mul_epu32(mixed, _mm256_shuffle_epi32(mixed, _MM_SHUFFLE(0, 3, 0, 1)));
+            __m256i swapped = _mm256_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+            lanes[i] = _mm256_add_epi64(product, _mm256_add_epi64(lanes[i], swapped));
+        }
+    }
+    for (size_t i = 0; i < 2; ++i) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc) + i, lanes[i]);
+    }
+}
+
+// scramble accumulators with four lanes per register
+__attribute__((target("avx2")))
+static void scrambleAvx2(uint64_t acc[8], const uint8_t* secret) {
+    const __m256i prime = _mm256_set1_epi32(static_cast<int>(Prime32_1));
+    for (size_t i = 0; i < 2; ++i) {
+        __m256i lane = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc) + i);
+        lane = _mm256_xor_si256(lane, _mm256_srli_epi64(lane, 47));
+        lane = _mm256_xor_si256(lane, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret) + i));
+        __m256i low = _mm256_mul_epu32(lane, prime);
+        __m256i high = _mm256_mul_epu32(_mm256_shuffle_epi32(lane, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc) + i, _mm256_add_epi64(low, _mm256_slli_epi64(high, 32)));
+    }
+}
+#endif
+
+// cpu support of the avx2 kernels
+static bool avx2Available() {
+#ifdef XXH3_AVX2
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+// accumulate stripes with the widest kernel the cpu supports
+static void accumulate(uint64_t acc[8], const uint8_t* data, const uint8_t* secret, size_t stripes) {
+#ifdef XXH3_AVX2
+    if (avx2Available()) {
+        accumulateAvx2(acc, data, secret, stripes);
+        return;
+    }
+#endif
+    accumulateBaseline(acc, data, secret, stripes);
+}
+
+// scramble accumulators with the widest kernel the cpu supports
+static void scramble(uint64_t acc[8], const uint8_t* secret) {
+#ifdef XXH3_AVX2
+    if (avx2Available()) {
+        scrambleAvx2(acc, secret);
+        return;
+    }
+#endif
+    scrambleBaseline(acc, secret);
+}
+
+// accumulate one stripe
+static inline void accumulateStripe(uint64_t acc[8], const uint8_t* stripe, const uint8_t* secret) {
+    accumulate(acc, stripe, secret, 1);
+}
+
+// accumulate stripes across a block boundary
+static void consumeStripes(uint64_t acc[8], size_t& stripesSoFar, size_t stripesPerBlock, const uint8_t* data,
+                           size_t stripes, const uint8_t* secret, size_t secretLimit) {
+    if (stripesPerBlock - stripesSoFar <= stripes) {
+        size_t toEnd = stripesPerBlock - stripesSoFar;
+        accumulate(acc, data, secret + stripesSoFar * 8, toEnd);
+        scramble(acc, secret + secretLimit);
+        accumulate(acc, data + toEnd * 64, secret, stripes - toEnd);
+        stripesSoFar = stripes - toEnd;
+    } else {
+        accumulate(acc, data, secret + stripesSoFar * 8, stripes);
+        stripesSoFar += stripes;
+    }
+}
+
+// initial accumulators
+static void initAccumulators(uint64_t acc[8]) {
+    acc[0] = Prime32_3;
+    acc[1] = Prime64_1;
+    acc[2] = Prime64_2;
+    acc[3] = Prime64_3;
+    acc[4] = Prime64_4;
+    acc[5] = Prime32_2;
+    acc[6] = Prime64_5;
+    acc[7] = Prime32_1;
+}
+
+// secret of a seed
+static void deriveSecret(uint64_t seed, uint8_t secret[192]) {
+    for (size_t i = 0; i < 192; i += 16) {
+        write64(secret + i, read64(DefaultSecret + i) + seed);
+        write64(secret + i + 8, read64(DefaultSecret + i + 8) - seed);
+    }
+}
+
+// accumulators over a whole input longer than MidSizeMax
+static void accumulateLong(uint64_t acc[8], const uint8_t* data, size_t length, const uint8_t* secret) {
+    const size_t secretLimit = 192 - 64;
+    const size_t stripesPerBlock = secretLimit / 8;
+    const size_t blockLength = 64 * stripesPerBlock;
+    size_t blocks = (length - 1) / blockLength;
+
+    initAccumulators(acc);
+    for (size_t n = 0; n < blocks; ++n) {
+        accumulate(acc, data + n * blockLength, secret, stripesPerBlock);
+        scramble(acc, secret + secretLimit);
+    }
+
+    // last partial block, then the last stripe which may overlap it
+    size_t stripes = ((length - 1) - blockLength * blocks) / 64;
+    accumulate(acc, data + blocks * blockLength, secret, stripes);
+    accumulateStripe(acc, data + length - 64, secret + secretLimit - LastAccStart);
+}
+
+// fold accumulators
+static uint64_t mergeAccumulators(const uint64_t acc[8], const uint8_t* secret, uint64_t start) {
+    uint64_t result = start;
+    for (size_t i = 0; i < 4; ++i) {
+        result += multiplyFold(acc[2 * i] ^ read64(secret + 16 * i), acc[2 * i + 1] ^ read64(secret + 16 * i + 8));
+    }
+    return avalanche(result);
+}
+
+// one shot 64-bit hash
+uint64_t XXH3::oneShot64(const uint8_t* data, size_t length, uint64_t seed) {
+    const uint8_t* secret = DefaultSecret;
+
+    if (length == 0) {
+        return avalanche64(seed ^ (read64(secret + 56) ^ read64(secret + 64)));
+    }
+    if (length <= 3) {
+        uint32_t combined = (static_cast<uint32_t>(data[0]) << 16) | (static_cast<uint32_t>(data[length >> 1]) << 24) |
+                            data[length - 1] | (static_cast<uint32_t>(length) << 8);
+        uint64_t bitflip = (read32(secret) ^ read32(secret + 4)) + seed;
+        return avalanche64(combined ^ bitflip);
+    }
+    if (length <= 8) {
+        seed ^= static_cast<uint64_t>(swap32(static_cast<uint32_t>(seed))) << 32;
+        uint64_t bitflip = (read64(secret + 8) ^ read64(secret + 16)) - seed;
+        uint64_t input = read32(data + length - 4) + (static_cast<uint64_t>(read32(data)) << 32);
+        return rrmxmx(input ^ bitflip, length);
+    }
+    if (length <= 16) {
+        uint64_t bitflip1 = (read64(secret + 24) ^ read64(secret + 32)) + seed;
+        uint64_t bitflip2 = (read64(secret + 40) ^ read64(secret + 48)) - seed;
+        uint64_t low = read64(data) ^ bitflip1;
+        uint64_t high = read64(data + length - 8) ^ bitflip2;
+        return avalanche(length + swap64(low) + high + multiplyFold(low, high));
+    }
+    if (length <= 128) {
+        uint64_t acc = length * Prime64_1;
+        if (length > 32) {
+            if (length > 64) {
+                if (length > 96) {
+                    acc += mix16(data + 48, secret + 96, seed);
+                    acc += mix16(data + length - 64, secret + 112, seed);
+                }
+                acc += mix16(data + 32, secret + 64, seed);
+                acc += mix16(data + length - 48, secret + 80, seed);
+            }
+            acc += mix16(data + 16, secret + 32, seed);
+            acc += mix16(data + length - 32, secret + 48, seed);
+        }
+        acc += mix16(data, secret, seed);
+        acc += mix16(data + length - 16, secret + 16, seed);
+        return avalanche(acc);
+    }
+    if (length <= MidSizeMax) {
+        uint64_t acc = length * Prime64_1;
+        size_t rounds = length / 16;
+        for (size_t i = 0; i < 8; ++i) {
+            acc += mix16(data + 16 * i, secret + 16 * i, seed);
+        }
+        acc = avalanche(acc);
+        for (size_t i = 8; i < rounds; ++i) {
+            acc += mix16(data + 16 * i, secret + 16 * (i - 8) + MidSizeStartOffset, seed);
+        }
+        acc += mix16(data + length - 16, secret + SecretSizeMin - MidSizeLastOffset, seed);
+        return avalanche(acc);
+    }
+
+    // long input, a seed changes the secret instead of the mixing
+    uint8_t custom[SecretSize];
+    if (seed != 0) {
+        deriveSecret(seed, custom);
+        secret = custom;
+    }
+    uint64_t acc[8];
+    accumulateLong(acc, data, length, secret);
+    return mergeAccumulators(acc, secret + MergeAccsStart, length * Prime64_1);
+}
+
+// one shot 128-bit hash
+XXH128Value XXH3::oneShot128(const uint8_t* data, size_t length, uint64_t seed) {
+    const uint8_t* secret = DefaultSecret;
+
+    if (length == 0) {
+        return {avalanche64(seed ^ read64(secret + 64) ^ read64(secret + 72)),
+                avalanche64(seed ^ read64(secret + 80) ^ read64(secret + 88))};
+    }
+    if (length <= 3) {
+        uint32_t combinedLow = (static_cast<uint32_t>(data[0]) << 16) | (static_cast<uint32_t>(data[length >> 1]) << 24) |
+                               data[length - 1] | (static_cast<uint32_t>(length) << 8);
+        uint32_t combinedHigh = rotl32(swap32(combinedLow), 13);
+        uint64_t bitflipLow = (read32(secret) ^ read32(secret + 4)) + seed;
+        uint64_t bitflipHigh = (read32(secret + 8) ^ read32(secret + 12)) - seed;
+        return {avalanche64(combinedLow ^ bitflipLow), avalanche64(combinedHigh ^ bitflipHigh)};
+    }
+    if (length <= 8) {
+        seed ^= static_cast<uint64_t>(swap32(static_cast<uint32_t>(seed))) << 32;
+        uint64_t input = read32(data) + (static_cast<uint64_t>(read32(data + length - 4)) << 32);
+        uint64_t bitflip = (read64(secret + 16) ^ read64(secret + 24)) + seed;
+        XXH128Value m = multiply(input ^ bitflip, Prime64_1 + (length << 2));
+        m.high += m.low << 1;
+        m.low ^= m.high >> 3;
+        m.low ^= m.low >> 35;
+        m.low *= PrimeMx2;
+        m.low ^= m.low >> 28;
+        m.high = avalanche(m.high);
+        return m;
+    }
+    if (length <= 16) {
+        uint64_t bitflipLow = (read64(secret + 32) ^ read64(secret + 40)) - seed;
+        uint64_t bitflipHigh = (read64(secret + 48) ^ read64(secret + 56)) + seed;
+        uint64_t inputLow = read64(data);
+        uint64_t inputHigh = read64(data + length - 8);
+        XXH128Value m = multiply(inputLow ^ inputHigh ^ bitflipLow, Prime64_1);
+        m.low += static_cast<uint64_t>(length - 1) << 54;
+        inputHigh ^= bitflipHigh;
+        m.high += inputHigh + (inputHigh & 0xFFFFFFFF) * (Prime32_2 - 1);
+        m.low ^= swap64(m.high);
+        XXH128Value h = multiply(m.low, Prime64_2);
+        h.high += m.high * Prime64_2;
+        return {avalanche(h.low), avalanche(h.high)};
+    }
+    if (length <= MidSizeMax) {
+        XXH128Value acc = {length * Prime64_1, 0};
+        if (length <= 128) {
+            if (length > 32) {
+                if (length > 64) {
+                    if (length > 96) {
+                        acc = mix32(acc, data + 48, data + length - 64, secret + 96, seed);
+                    }
+                    acc = mix32(acc, data + 32, data + length - 48, secret + 64, seed);
+                }
+                acc = mix32(acc, data + 16, data + length - 32, secret + 32, seed);
+            }
+            acc = mix32(acc, data, data + length - 16, secret, seed);
+        } else {
+            size_t rounds = length / 32;
+            for (size_t i = 0; i < 4; ++i) {
+                acc = mix32(acc, data + 32 * i, data + 32 * i + 16, secret + 32 * i, seed);
+            }
+            acc.low = avalanche(acc.low);
+            acc.high = avalanche(acc.high);
+            for (size_t i = 4; i < rounds; ++i) {
+                acc = mix32(acc, data + 32 * i, data + 32 * i + 16, secret + MidSizeStartOffset + 32 * (i - 4), seed);
+            }
+            acc = mix32(acc, data + length - 16, data + length - 32, secret + SecretSizeMin - MidSizeLastOffset - 16,
+                        0 - seed);
+        }
+        uint64_t low = acc.low + acc.high;
+        uint64_t high = acc.low * Prime64_1 + acc.high * Prime64_4 + (length - seed) * Prime64_2;
+        return {avalanche(low), 0 - avalanche(high)};
+    }
+
+    // long input, a seed changes the secret instead of the mixing
+    uint8_t custom[SecretSize];
+    if (seed != 0) {
+        deriveSecret(seed, custom);
+        secret = custom;
+    }
+    uint64_t acc[8];
+    accumulateLong(acc, data, length, secret);
+    return {mergeAccumulators(acc, secret + MergeAccsStart, length * Prime64_1),
+            mergeAccumulators(acc, secret + SecretSize - 64 - MergeAccsStart, ~(length * Prime64_2))};
+}
+
+// xxh3 constructor
+XXH3::XXH3(uint64_t seed) : seed(seed) {
+    if (seed != 0) {
+        deriveSecret(seed, secret);
+    } else {
+        std::memcpy(secret, DefaultSecret, SecretSize);
+    }
+    reset();
+}
+
+// reset object state
+void XXH3::reset() {
+    initAccumulators(acc);
+    stripesSoFar = 0;
+    totalLength = 0;
+    bufferIndex = 0;
+}
+
+// update state
+void XXH3::update(const std::string& data) {
+    update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+}
+
+// update state with raw bytes, at least one byte always stays buffered for the final stripe
+void XXH3::update(const uint8_t* data, size_t length) {
+    if (length == 0) {
+        return;
+    }
+    totalLength += length;
+
+    // fits in the remaining buffer
+    if (length <= BufferSize - bufferIndex) {
+        std::memcpy(buffer + bufferIndex, data, length);
+        bufferIndex += length;
+        return;
+    }
+
+    // complete and consume the buffer first
+    const size_t bufferStripes = BufferSize / StripeSize;
+    if (bufferIndex > 0) {
+        size_t take = BufferSize - bufferIndex;
+        std::memcpy(buffer + bufferIndex, data, take);
+        data += take;
+        length -= take;
+        consumeStripes(acc, stripesSoFar, StripesPerBlock, buffer, bufferStripes, secret, SecretSize - StripeSize);
+        bufferIndex = 0;
+    }
+
+    // consume buffer sized runs straight from the input
+    if (length > BufferSize) {
+        do {
+            consumeStripes(acc, stripesSoFar, StripesPerBlock, data, bufferStripes, secret, SecretSize - StripeSize);
+            data += BufferSize;
+            length -= BufferSize;
+        } while (length > BufferSize);
+
+        // keep the last consumed stripe for a short final block
+        std::memcpy(buffer + BufferSize - StripeSize, data - StripeSize, StripeSize);
+    }
+
+    // keep the tail for the next call
+    std::memcpy(buffer, data, length);
+    bufferIndex = length;
+}
+
+// accumulators including the buffered tail
+void XXH3::finalAccumulators(uint64_t out[8]) const {
+    std::memcpy(out, acc, sizeof(acc));
+    const size_t secretLimit = SecretSize - StripeSize;
+
+    if (bufferIndex >= StripeSize) {
+        size_t stripes = (bufferIndex - 1) / StripeSize;
+        size_t soFar = stripesSoFar;
+        consumeStripes(out, soFar, StripesPerBlock, buffer, stripes, secret, secretLimit);
+        accumulateStripe(out, buffer + bufferIndex - StripeSize, secret + secretLimit - LastAccStart);
+    } else {
+        // the last stripe starts in data already consumed
+        uint8_t lastStripe[StripeSize];
+        size_t catchup = StripeSize - bufferIndex;
+        std::memcpy(lastStripe, buffer + BufferSize - catchup, catchup);
+        std::memcpy(lastStripe + catchup, buffer, bufferIndex);
+        accumulateStripe(out, lastStripe, secret + secretLimit - LastAccStart);
+    }
+}
+
+// 64-bit value of the fed data, short inputs are still whole in the buffer
+uint64_t XXH3::value64() const {
+    if (totalLength <= MidSizeMax) {
+        return oneShot64(buffer, bufferIndex, seed);
+    }
+    uint64_t out[8];
+    finalAccumulators(out);
+    return mergeAccumulators(out, secret + MergeAccsStart, totalLength * Prime64_1);
+}
+
+// 128-bit value of the fed data
+XXH128Value XXH3::value128() const {
+    if (totalLength <= MidSizeMax) {
+        return oneShot128(buffer, bufferIndex, seed);
+    }
+    uint64_t out[8];
+    finalAccumulators(out);
+    return {mergeAccumulators(out, secret + MergeAccsStart, totalLength * Prime64_1),
+            mergeAccumulators(out, secret + SecretSize - StripeSize - MergeAccsStart, ~(totalLength * Prime64_2))};
+}
+
+// finalize value
+uint64_t XXH3::finalValue() {
+    uint64_t value = value64();
+    reset(); // reset state
+    return value;
+}
+
+// finalize binary hash
+void XXH3::final(uint8_t digest[OutputSize]) {
+    uint64_t value = finalValue();
+    for (size_t i = 0; i < OutputSize; ++i) {
+        digest[i] = static_cast<uint8_t>(value >> (56 - 8 * i));
+    }
+}
+
+// finalize hash
+std::string XXH3::final() {
+    std::ostringstream result;
+    result << std::hex << std::setw(16) << std::setfill('0') << finalValue();
+    return result.str();
+}
+
+// compute hash value
+uint64_t XXH3::hashValue(const uint8_t* data, size_t length, uint64_t seed) {
+    return oneShot64(data, length, seed);
+}
+
+// compute binary hash
+void XXH3::hash(const uint8_t* data, size_t length, uint8_t digest[OutputSize]) {
+    uint64_t value = oneShot64(data, length, 0);
+    for (size_t i = 0; i < OutputSize; ++i) {
+        digest[i] = static_cast<uint8_t>(value >> (56 - 8 * i));
+    }
+}
+
+// compute hash
+std::string XXH3::hash(const std::string& data) {
+    XXH3 xxh3;
+    xxh3.update(data);
+    return xxh3.final();
+}
+
+// write streaming state, the secret is derived again from the seed
+void XXH3::saveState(HashStateWriter& writer) const {
+    writer.putWord(seed, 8);
+    for (uint64_t lane : acc) {
+        writer.putWord(lane, 8);
+    }
+    writer.putWord(stripesSoFar, 1);
+    writer.putWord(totalLength, 8);
+    writer.putWord(bufferIndex, 2);
+    writer.putBytes(buffer, BufferSize);
+}
+
+// restore streaming state
+void XXH3::loadState(HashStateReader& reader) {
+    seed = reader.getWord(8);
+    if (seed != 0) {
+        deriveSecret(seed, secret);
+    } else {
+        std::memcpy(secret, DefaultSecret, SecretSize);
+    }
+    for (uint64_t& lane : acc) {
+        lane = reader.getWord(8);
+    }
+    stripesSoFar = static_cast<size_t>(reader.getWord(1));
+    totalLength = reader.getWord(8);
+    bufferIndex = static_cast<size_t>(reader.getWord(2));
+    if (stripesSoFar >= StripesPerBlock || bufferIndex > BufferSize || bufferIndex > totalLength ||
+        (totalLength > 0 && bufferIndex == 0)) {
+        throw std::runtime_error("Invalid hash state");
+    }
+    reader.getBytes(buffer, BufferSize);
+}
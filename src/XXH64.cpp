@@ -0,0 +1,220 @@
+#include "XXH64.h"
+#include "HashState.h"
+#include <sstream>
+#include <iomanip>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept> // Error handling
+
+// primes
+static constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ULL;
+static constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4FULL;
+static constexpr uint64_t Prime3 = 0x165667B19E3779F9ULL;
+static constexpr uint64_t Prime4 = 0x85EBCA77C2B2AE63ULL;
+static constexpr uint64_t Prime5 = 0x27D4EB2F165667C5ULL;
+
+// rotate bits left n times
+static inline uint64_t rotl(uint64_t x, int n) {
+    return (x << n) | (x >> (64 - n));
+}
+
+// load little-endian words
+static inline uint64_t read64(const uint8_t* p) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) {
+        value = (value << 8) | p[i];
+    }
+    return value;
+}
+
+static inline uint32_t read32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// mix one lane
+static inline uint64_t mixLane(uint64_t acc, uint64_t input) {
+    acc += input * Prime2;
+    acc = rotl(acc, 31);
+    return acc * Prime1;
+}
+
+// fold an accumulator into the hash
+static inline uint64_t mergeRound(uint64_t h, uint64_t acc) {
+    h ^= mixLane(0, acc);
+    return h * Prime1 + Prime4;
+}
+
+// hash four lanes of 32 byte stripes
+static void processStripes(uint64_t acc[4], const uint8_t* data, size_t stripes) {
+    uint64_t v1 = acc[0], v2 = acc[1], v3 = acc[2], v4 = acc[3];
+    for (size_t i = 0; i < stripes; ++i, data += 32) {
+        v1 = mixLane(v1, read64(data));
+        v2 = mixLane(v2, read64(data + 8));
+        v3 = mixLane(v3, read64(data + 16));
+        v4 = mixLane(v4, read64(data + 24));
+    }
+    acc[0] = v1;
+    acc[1] = v2;
+    acc[2] = v3;
+    acc[3] = v4;
+}
+
+// xxh64 constructor
+XXH64::XXH64(uint64_t seed) : seed(seed) {
+    reset();
+}
+
+// reset object state
+void XXH64::reset() {
+    acc[0] = seed + Prime1 + Prime2;
+    acc[1] = seed + Prime2;
+    acc[2] = seed;
+    acc[3] = seed - Prime1;
+    totalLength = 0;
+    bufferIndex = 0;
+}
+
+// update state
+void XXH64::update(const std::string& data) {
+    update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+}
+
+// update state with raw bytes
+void XXH64::update(const uint8_t* data, size_t length) {
+    if (length == 0) {
+        return;
+    }
+    totalLength += length;
+
+    // complete a partially filled buffer first
+    if (bufferIndex > 0) {
+        size_t take = std::min(length, StripeSize - bufferIndex);
+        std::memcpy(buffer + bufferIndex, data, take);
+        bufferIndex += take;
+        data += take;
+        length -= take;
+
+        if (bufferIndex < StripeSize) {
+            return;
+        }
+        processStripes(acc, buffer, 1);
+        bufferIndex = 0;
+    }
+
+    // process full stripes straight from the input
+    processStripes(acc, data, length / StripeSize);
+    data += length / StripeSize * StripeSize;
+    length %= StripeSize;
+
+    // keep the tail for the next call
+    std::memcpy(buffer, data, length);
+    bufferIndex = length;
+}
+
+// mix tail and avalanche
+uint64_t XXH64::finish(uint64_t h, const uint8_t* tail, size_t length) {
+    while (length >= 8) {
+        h ^= mixLane(0, read64(tail));
+        h = rotl(h, 27) * Prime1 + Prime4;
+        tail += 8;
+        length -= 8;
+    }
+    if (length >= 4) {
+        h ^= static_cast<uint64_t>(read32(tail)) * Prime1;
+        h = rotl(h, 23) * Prime2 + Prime3;
+        tail += 4;
+        length -= 4;
+    }
+    while (length > 0) {
+        h ^= *tail++ * Prime5;
+        h = rotl(h, 11) * Prime1;
+        --length;
+    }
+
+    h ^= h >> 33;
+    h *= Prime2;
+    h ^= h >> 29;
+    h *= Prime3;
+    h ^= h >> 32;
+    return h;
+}
+
+// finalize value
+uint64_t XXH64::finalValue() {
+    uint64_t h;
+    if (totalLength >= StripeSize) {
+        h = rotl(acc[0], 1) + rotl(acc[1], 7) + rotl(acc[2], 12) + rotl(acc[3], 18);
+        for (uint64_t lane : acc) {
+            h = mergeRound(h, lane);
+        }
+    } else {
+        h = seed + Prime5;
+    }
+    h += totalLength;
+    h = finish(h, buffer, bufferIndex);
+
+    reset(); // reset state
+    return h;
+}
+
+// finalize binary hash
+void XXH64::final(uint8_t digest[OutputSize]) {
+    uint64_t value = finalValue();
+    for (size_t i = 0; i < OutputSize; ++i) {
+        digest[i] = static_cast<uint8_t>(value >> (56 - 8 * i));
+    }
+}
+
+// finalize hash
+std::string XXH64::final() {
+    std::ostringstream result;
+    result << std::hex << std::setw(16) << std::setfill('0') << finalValue();
+    return result.str();
+}
+
+// compute hash value
+uint64_t XXH64::hashValue(const uint8_t* data, size_t length, uint64_t seed) {
+    XXH64 xxh64(seed);
+    xxh64.update(data, length);
+    return xxh64.finalValue();
+}
+
+// compute binary hash
+void XXH64::hash(const uint8_t* data, size_t length, uint8_t digest[OutputSize]) {
+    XXH64 xxh64;
+    xxh64.update(data, length);
+    xxh64.final(digest);
+}
+
+// compute hash
+std::string XXH64::hash(const std::string& data) {
+    XXH64 xxh64;
+    xxh64.update(data);
+    return xxh64.final();
+}
+
+// write streaming state
+void XXH64::saveState(HashStateWriter& writer) const {
+    writer.putWord(seed, 8);
+    for (uint64_t lane : acc) {
+        writer.putWord(lane, 8);
+    }
+    writer.putWord(totalLength, 8);
+    writer.putWord(bufferIndex, 1);
+    writer.putBytes(buffer, bufferIndex);
+}
+
+// restore streaming state
+void XXH64::loadState(HashStateReader& reader) {
+    seed = reader.getWord(8);
+    for (uint64_t& lane : acc) {
+        lane = reader.getWord(8);
+    }
+    totalLength = reader.getWord(8);
+    bufferIndex = static_cast<size_t>(reader.getWord(1));
+    if (bufferIndex != totalLength % StripeSize) {
+        throw std::runtime_error("Invalid hash state");
+    }
+    reader.getBytes(buffer, bufferIndex);
+}